@@ -0,0 +1,548 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#include <boost/url/params_index.hpp>
+#include <boost/url/parse.hpp>
+#include <boost/url/static_url.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+namespace bench {
+
+using clock_type =
+    std::chrono::steady_clock;
+
+struct corpus
+{
+    char const* name;
+    std::vector<std::string> v;
+};
+
+// Deterministic so runs are comparable
+class lcg
+{
+    unsigned long long s_;
+
+public:
+    explicit
+    lcg(unsigned long long seed)
+        : s_(seed)
+    {
+    }
+
+    std::size_t
+    operator()(std::size_t n)
+    {
+        s_ = s_ * 6364136223846793005ULL +
+            1442695040888963407ULL;
+        return static_cast<std::size_t>(
+            s_ >> 33) % n;
+    }
+};
+
+std::string
+make_label(lcg& r, std::size_t n)
+{
+    static char const cs[] =
+        "abcdefghijklmnopqrstuvwxyz0123456789-";
+    std::string s;
+    s.reserve(n);
+    while(n--)
+        s.push_back(cs[r(sizeof(cs) - 2)]);
+    return s;
+}
+
+std::string
+make_host(lcg& r)
+{
+    std::string s = make_label(r, 3 + r(12));
+    auto n = 1 + r(4);
+    while(n--)
+    {
+        s.push_back('.');
+        s += make_label(r, 2 + r(16));
+    }
+    return s;
+}
+
+std::vector<corpus>
+make_corpora()
+{
+    std::size_t const N = 10000;
+    lcg r(1);
+    std::vector<corpus> v;
+
+    // Long hostnames, no userinfo
+    v.push_back({ "host", {} });
+    for(std::size_t i = 0; i < N; ++i)
+        v.back().v.push_back(
+            "http://" + make_host(r) + "/");
+
+    // Hostname and port
+    v.push_back({ "host:port", {} });
+    for(std::size_t i = 0; i < N; ++i)
+        v.back().v.push_back(
+            "https://" + make_host(r) + ":" +
+            std::to_string(1 + r(65535)) +
+            "/index.html");
+
+    // IPv4 address and port
+    v.push_back({ "ipv4:port", {} });
+    for(std::size_t i = 0; i < N; ++i)
+        v.back().v.push_back(
+            "http://" +
+            std::to_string(r(256)) + "." +
+            std::to_string(r(256)) + "." +
+            std::to_string(r(256)) + "." +
+            std::to_string(r(256)) + ":" +
+            std::to_string(1 + r(65535)) + "/");
+
+    // Userinfo, host and port
+    v.push_back({ "userinfo", {} });
+    for(std::size_t i = 0; i < N; ++i)
+        v.back().v.push_back(
+            "ftp://" + make_label(r, 4 + r(8)) +
+            ":" + make_label(r, 6 + r(10)) +
+            "@" + make_host(r) + ":21/");
+
+    return v;
+}
+
+// Returns nanoseconds per URL,
+// best of several trials.
+double
+run(corpus const& c, std::size_t trials)
+{
+    double best = 0;
+    std::size_t sum = 0;
+    for(std::size_t t = 0; t < trials; ++t)
+    {
+        auto const t0 = clock_type::now();
+        for(auto const& s : c.v)
+        {
+            auto const r =
+                parse_uri_reference(s);
+            if(! r)
+            {
+                std::fprintf(stderr,
+                    "parse failed: %s\n",
+                    s.c_str());
+                std::exit(EXIT_FAILURE);
+            }
+            sum += r->encoded_host().size();
+        }
+        auto const t1 = clock_type::now();
+        double const ns = static_cast<double>(
+            std::chrono::duration_cast<
+                std::chrono::nanoseconds>(
+                    t1 - t0).count()) / c.v.size();
+        if(t == 0 || ns < best)
+            best = ns;
+    }
+    // keep the work observable
+    if(sum == 0)
+        std::fprintf(stderr, "empty\n");
+    return best;
+}
+
+// Look up a dozen keys in a query with
+// n parameters. Returns nanoseconds per
+// URL, best of several trials.
+template<class F>
+double
+run_lookup(
+    std::size_t n,
+    std::size_t trials,
+    F const& f)
+{
+    lcg r(2);
+    std::string s = "/api?";
+    std::vector<std::string> keys;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        keys.push_back(make_label(r, 4 + r(8)) +
+            std::to_string(i));
+        if(i > 0)
+            s.push_back('&');
+        s += keys.back() + "=" +
+            make_label(r, 1 + r(12));
+    }
+    std::vector<std::string> probes;
+    for(std::size_t i = 0; i < 12; ++i)
+        probes.push_back(keys[r(n)]);
+    probes.back() = "missing";
+    url_view const u(s);
+
+    double best = 0;
+    std::size_t sum = 0;
+    std::size_t const reps = 1000;
+    for(std::size_t t = 0; t < trials; ++t)
+    {
+        auto const t0 = clock_type::now();
+        for(std::size_t i = 0; i < reps; ++i)
+            sum += f(u, probes);
+        auto const t1 = clock_type::now();
+        double const ns = static_cast<double>(
+            std::chrono::duration_cast<
+                std::chrono::nanoseconds>(
+                    t1 - t0).count()) / reps;
+        if(t == 0 || ns < best)
+            best = ns;
+    }
+    if(sum == 0)
+        std::fprintf(stderr, "empty\n");
+    return best;
+}
+
+void
+run_lookups(std::size_t trials)
+{
+    for(std::size_t n : { 10, 50, 200 })
+    {
+        auto const linear = run_lookup(n, trials,
+            []( url_view const& u,
+                std::vector<std::string> const& v)
+            {
+                std::size_t sum = 0;
+                auto const p = u.params();
+                for(auto const& k : v)
+                    sum += p.count(k);
+                return sum;
+            });
+        auto const hashed = run_lookup(n, trials,
+            []( url_view const& u,
+                std::vector<std::string> const& v)
+            {
+                std::size_t sum = 0;
+                static_params_index<200> idx;
+                auto const p = u.params(idx);
+                for(auto const& k : v)
+                    sum += p.count(k);
+                return sum;
+            });
+        std::printf(
+            "params %-5u linear %8.1f ns/url"
+            "  indexed %8.1f ns/url\n",
+            static_cast<unsigned>(n),
+            linear, hashed);
+    }
+}
+
+// The decoder before it was vectorized:
+// a sizing pass, then a byte at a time
+std::string
+scalar_decode(string_view s)
+{
+    std::size_t n = 0;
+    for(auto p = s.begin(); p < s.end();)
+    {
+        p += *p == '%' ? 3 : 1;
+        ++n;
+    }
+    std::string r;
+    r.resize(n);
+    auto dest = &r[0];
+    for(auto p = s.begin(); p < s.end();)
+    {
+        if(*p != '%')
+        {
+            *dest++ = *p++;
+            continue;
+        }
+        *dest++ = static_cast<char>(
+            (static_cast<unsigned char>(
+                detail::hex_digit(p[1])) << 4) +
+            static_cast<unsigned char>(
+                detail::hex_digit(p[2])));
+        p += 3;
+    }
+    return r;
+}
+
+// Returns nanoseconds per string,
+// best of several trials.
+template<class F>
+double
+run_decode(
+    std::vector<std::string> const& v,
+    std::size_t trials,
+    F const& f)
+{
+    double best = 0;
+    std::size_t sum = 0;
+    for(std::size_t t = 0; t < trials; ++t)
+    {
+        auto const t0 = clock_type::now();
+        for(auto const& s : v)
+            sum += f(s).size();
+        auto const t1 = clock_type::now();
+        double const ns = static_cast<double>(
+            std::chrono::duration_cast<
+                std::chrono::nanoseconds>(
+                    t1 - t0).count()) / v.size();
+        if(t == 0 || ns < best)
+            best = ns;
+    }
+    if(sum == 0)
+        std::fprintf(stderr, "empty\n");
+    return best;
+}
+
+void
+run_decodes(std::size_t trials)
+{
+    std::size_t const N = 1000;
+    lcg r(3);
+    std::vector<corpus> v;
+
+    // Paths with no escapes
+    v.push_back({ "plain", {} });
+    for(std::size_t i = 0; i < N; ++i)
+        v.back().v.push_back("/" +
+            make_label(r, 20 + r(60)) + "/" +
+            make_label(r, 20 + r(60)));
+
+    // An escaped space every few words
+    v.push_back({ "sparse", {} });
+    for(std::size_t i = 0; i < N; ++i)
+    {
+        std::string s;
+        auto n = 4 + r(8);
+        while(n--)
+            s += make_label(r, 3 + r(10)) + "%20";
+        v.back().v.push_back(s);
+    }
+
+    // Percent-encoded UTF-8
+    v.push_back({ "dense", {} });
+    for(std::size_t i = 0; i < N; ++i)
+    {
+        std::string s;
+        auto n = 8 + r(24);
+        while(n--)
+            s += "%E4%B8%AD";
+        v.back().v.push_back(s);
+    }
+
+    for(auto const& c : v)
+    {
+        auto const before = run_decode(c.v, trials,
+            [](std::string const& s)
+            {
+                return scalar_decode(s);
+            });
+        auto const after = run_decode(c.v, trials,
+            [](std::string const& s)
+            {
+                return detail::decode(s,
+                    std::allocator<char>{});
+            });
+        std::printf(
+            "decode %-6s scalar %8.1f ns/str"
+            "  vector %8.1f ns/str\n",
+            c.name, before, after);
+    }
+}
+
+// The encoder before it was vectorized:
+// a sizing pass, then a byte at a time
+std::string
+scalar_encode(
+    string_view s,
+    char const* tab)
+{
+    static constexpr char hex[] =
+        "0123456789ABCDEF";
+    std::size_t n = 0;
+    for(char c : s)
+        n += tab[static_cast<
+            unsigned char>(c)];
+    std::string r;
+    r.resize(n);
+    auto dest = &r[0];
+    for(char c : s)
+    {
+        auto const u = static_cast<
+            unsigned char>(c);
+        if(tab[u] != '\3')
+        {
+            *dest++ = c;
+            continue;
+        }
+        dest[0] = '%';
+        dest[1] = hex[u >> 4];
+        dest[2] = hex[u & 0xf];
+        dest += 3;
+    }
+    return r;
+}
+
+void
+run_encodes(std::size_t trials)
+{
+    std::size_t const N = 1000;
+    lcg r(4);
+
+    // Mostly unreserved text with
+    // the odd space and delimiter
+    std::vector<std::string> v;
+    for(std::size_t i = 0; i < N; ++i)
+    {
+        static char const cs[] = " /?=&:@";
+        std::string s;
+        auto n = 4 + r(8);
+        while(n--)
+        {
+            s += make_label(r, 3 + r(12));
+            s.push_back(cs[r(sizeof(cs) - 1)]);
+        }
+        v.push_back(s);
+    }
+
+    struct set
+    {
+        char const* name;
+        char const* tab;
+        detail::pct_encoding e;
+    };
+    using t = detail::char_tables<>;
+    set const sets[] = {
+        { "pchar", t::pchar, detail::pchar_pct_set() },
+        { "qkey", t::qkey, detail::qkey_pct_set() },
+        { "qval", t::qval, detail::qval_pct_set() },
+        { "frag", t::frag, detail::frag_pct_set() },
+        { "reg_name", t::reg_name, detail::reg_name_pct_set() },
+        { "userinfo", t::userinfo, detail::userinfo_pct_set() } };
+    for(auto const& e : sets)
+    {
+        auto const tab = e.tab;
+        auto const pct = e.e;
+        auto const before = run_decode(v, trials,
+            [tab](std::string const& s)
+            {
+                return scalar_encode(s, tab);
+            });
+        auto const after = run_decode(v, trials,
+            [pct](std::string const& s)
+            {
+                std::string r;
+                r.resize(pct.encoded_size(s));
+                pct.encode(&r[0], s);
+                return r;
+            });
+        std::printf(
+            "encode %-8s scalar %8.1f ns/str"
+            "  vector %8.1f ns/str\n",
+            e.name, before, after);
+    }
+}
+
+// Parse a URL into a container, modify it,
+// and copy it, as done for connection state.
+// Returns nanoseconds per URL, best of
+// several trials.
+template<class F>
+double
+run_container(
+    corpus const& c,
+    std::size_t trials,
+    F const& f)
+{
+    double best = 0;
+    std::size_t sum = 0;
+    for(std::size_t t = 0; t < trials; ++t)
+    {
+        auto const t0 = clock_type::now();
+        for(auto const& s : c.v)
+            sum += f(s);
+        auto const t1 = clock_type::now();
+        double const ns = static_cast<double>(
+            std::chrono::duration_cast<
+                std::chrono::nanoseconds>(
+                    t1 - t0).count()) / c.v.size();
+        if(t == 0 || ns < best)
+            best = ns;
+    }
+    if(sum == 0)
+        std::fprintf(stderr, "empty\n");
+    return best;
+}
+
+void
+run_containers(
+    std::vector<corpus> const& v,
+    std::size_t trials)
+{
+    using heap_url = basic_url<
+        std::allocator<char>>;
+    for(auto const& c : v)
+    {
+        auto const heap = run_container(c, trials,
+            [](std::string const& s)
+            {
+                heap_url u(s);
+                u.set_encoded_query("page=2");
+                heap_url u2;
+                u2.set_encoded_url(u.encoded_url());
+                return u2.size();
+            });
+        auto const sbo = run_container(c, trials,
+            [](std::string const& s)
+            {
+                url u(s);
+                u.set_encoded_query("page=2");
+                url u2;
+                u2.set_encoded_url(u.encoded_url());
+                return u2.size();
+            });
+        auto const fixed = run_container(c, trials,
+            [](std::string const& s)
+            {
+                static_url<1024> u(s);
+                u.set_encoded_query("page=2");
+                static_url<1024> u2(u);
+                return u2.size();
+            });
+        std::printf(
+            "url %-10s heap %8.1f  url %8.1f"
+            "  static_url %8.1f ns/url\n",
+            c.name, heap, sbo, fixed);
+    }
+}
+
+} // bench
+} // urls
+} // boost
+
+int
+main(int argc, char** argv)
+{
+    using namespace boost::urls::bench;
+    std::size_t trials = 200;
+    if(argc > 1)
+        trials = static_cast<std::size_t>(
+            std::atoi(argv[1]));
+    auto const v = make_corpora();
+    for(auto const& c : v)
+        std::printf("%-12s %8.1f ns/url\n",
+            c.name, run(c, trials));
+    run_containers(v, trials / 10 + 1);
+    run_lookups(trials / 10 + 1);
+    run_decodes(trials);
+    run_encodes(trials);
+    return EXIT_SUCCESS;
+}
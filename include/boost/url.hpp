@@ -13,10 +13,22 @@
 #include <boost/url/config.hpp>
 
 #include <boost/url/url_base.hpp>
+#include <boost/url/decode.hpp>
+#include <boost/url/decoded_view.hpp>
+#include <boost/url/equivalent.hpp>
 #include <boost/url/error.hpp>
 #include <boost/url/host_type.hpp>
+#include <boost/url/ipv4_address.hpp>
+#include <boost/url/ipv6_address.hpp>
+#include <boost/url/params_index.hpp>
+#include <boost/url/parse.hpp>
+#include <boost/url/parse_urls.hpp>
+#include <boost/url/resolve.hpp>
+#include <boost/url/result.hpp>
 #include <boost/url/scheme.hpp>
+#include <boost/url/segments_index.hpp>
 #include <boost/url/static_pool.hpp>
+#include <boost/url/url_parser.hpp>
 #include <boost/url/url_view.hpp>
 #include <boost/url/urls.hpp>
 
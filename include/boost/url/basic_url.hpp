@@ -13,22 +13,44 @@
 #include <boost/url/config.hpp>
 #include <boost/url/url_base.hpp>
 #include <boost/url/detail/storage.hpp>
+#include <memory>
 #include <utility>
 
 namespace boost {
 namespace urls {
 
 /** A container for storing a URL.
+
+    URLs of up to `InlineSize` characters are
+    stored in the object itself, without
+    allocating. Longer URLs are stored in memory
+    obtained from the allocator, and stay there
+    even if they shrink again.
+
+    @tparam Allocator The allocator to use
+    once the inline storage is outgrown.
+
+    @tparam InlineSize The number of characters,
+    not counting the null terminator, which may
+    be stored without allocating.
+
+    @see url
 */
-template<class Allocator>
+template<
+    class Allocator,
+    std::size_t InlineSize = 0>
 class basic_url
-    : private detail::storage_member<Allocator>
+    : private detail::storage_member<
+        Allocator, InlineSize>
     , public url_base
 {
+    using traits =
+        std::allocator_traits<Allocator>;
+
 public:
     basic_url() noexcept
         : detail::storage_member<
-            Allocator>(Allocator{})
+            Allocator, InlineSize>(Allocator{})
         , url_base(static_cast<
             detail::storage&>(this->st_))
     {
@@ -39,36 +61,162 @@ public:
         string_view s,
         Allocator const& a = {})
         : detail::storage_member<
-            Allocator>(a)
+            Allocator, InlineSize>(a)
         , url_base(this->st_, s)
     {
     }
 
+    /** Constructor.
+
+        The characters of the view are copied
+        using at most one allocation, of exactly
+        their size, and the positions of its parts
+        are used as they are, so the URL is not
+        parsed again.
+
+        @param v The URL to copy.
+
+        @param a The allocator to use.
+    */
+    explicit
+    basic_url(
+        url_view const& v,
+        Allocator const& a = {})
+        : detail::storage_member<
+            Allocator, InlineSize>(a)
+        , url_base(this->st_)
+    {
+        auto const s = this->st_.resize_exact(
+            view_size(v));
+        if(s)
+            copy_view(s, v);
+    }
+
     explicit
     basic_url(
         Allocator const& a) noexcept
         : detail::storage_member<
-            Allocator>(a)
+            Allocator, InlineSize>(a)
         , url_base(this->st_)
     {
     }
 
+    /** Constructor.
+
+        The allocator and the buffer are moved
+        from `other`, which becomes empty. If
+        `other` is stored inline, its characters
+        are copied instead.
+    */
     basic_url(
-        basic_url&&) noexcept
+        basic_url&& other) noexcept
+        : detail::storage_member<
+            Allocator, InlineSize>(
+                other.st_.get_allocator())
+        , url_base(this->st_)
     {
+        steal(other);
     }
 
+    /** Constructor.
+
+        The string and its parts are copied,
+        using one allocation of exactly the
+        size of the URL if it does not fit
+        in the inline storage.
+    */
     basic_url(
-        basic_url const&)
+        basic_url const& other)
+        : detail::storage_member<
+            Allocator, InlineSize>(
+                traits::select_on_container_copy_construction(
+                    other.st_.get_allocator()))
+        , url_base(this->st_)
+    {
+        copy(other);
+    }
+
+    /** Assignment.
+
+        If the allocator propagates on move
+        assignment, or is equal to that of
+        `other`, the buffer is moved from
+        `other`, which becomes empty. Otherwise
+        the URL is copied and `other` is
+        left unchanged.
+    */
+    basic_url&
+    operator=(
+        basic_url&& other) noexcept(
+            traits::propagate_on_container_move_assignment::value)
     {
+        if(this == &other)
+            return *this;
+        if(traits::
+            propagate_on_container_move_assignment::value)
+        {
+            this->st_.release();
+            this->st_.set_allocator(
+                other.st_.get_allocator());
+        }
+        else if(this->st_.get_allocator() !=
+            other.st_.get_allocator())
+        {
+            copy(other);
+            return *this;
+        }
+        steal(other);
+        return *this;
     }
 
+    /** Assignment.
+
+        The string and its parts are copied,
+        and the allocator too if it propagates
+        on copy assignment.
+    */
     basic_url&
     operator=(
-        basic_url const&)
+        basic_url const& other)
     {
+        if(this == &other)
+            return *this;
+        if( traits::
+                propagate_on_container_copy_assignment::value &&
+            this->st_.get_allocator() !=
+                other.st_.get_allocator())
+        {
+            // the buffer belongs to
+            // the old allocator
+            s_ = nullptr;
+            pt_ = detail::parts();
+            this->st_.release();
+            this->st_.set_allocator(
+                other.st_.get_allocator());
+        }
+        copy(other);
         return *this;
     }
+
+private:
+    void
+    copy(basic_url const& other)
+    {
+        s_ = this->st_.assign(
+            other.s_, other.size());
+        pt_ = other.pt_;
+    }
+
+    void
+    steal(basic_url& other) noexcept
+    {
+        s_ = other.s_ ?
+            this->st_.steal(other.st_) :
+            nullptr;
+        pt_ = other.pt_;
+        other.s_ = nullptr;
+        other.pt_ = detail::parts();
+    }
 };
 
 } // urls
@@ -0,0 +1,173 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_DECODE_HPP
+#define BOOST_URL_DECODE_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+#include <cstddef>
+#include <string>
+
+namespace boost {
+namespace urls {
+
+/** Return the size of a decoded string.
+
+    This function returns the exact number of
+    characters produced by decoding the
+    percent-encoded string `s`.
+
+    @par Precondition
+    Every '%' in `s` starts an escape of two hex
+    digits, as in the value returned by any of
+    the `encoded_` accessors of @ref url_view,
+    @ref url_base, or their segment and
+    parameter containers. The overload taking
+    an `error_code` checks this instead.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param s The percent-encoded string.
+*/
+BOOST_URL_DECL
+std::size_t
+decoded_size(
+    string_view s) noexcept;
+
+/** Return the size of a decoded string.
+
+    This function returns the exact number of
+    characters produced by decoding the
+    percent-encoded string `s`, after checking
+    that each of its escapes is complete.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @return The decoded size, or zero
+    if an error occurred.
+
+    @param s The percent-encoded string.
+
+    @param ec Set to the error, if any occurred:
+    @ref error::incomplete_pct_encoding or
+    @ref error::bad_pct_encoding_digit.
+*/
+BOOST_URL_DECL
+std::size_t
+decoded_size(
+    string_view s,
+    error_code& ec) noexcept;
+
+/** Decode a string into a caller-provided buffer.
+
+    This function decodes the percent-encoded
+    string `s` into the buffer, without
+    allocating memory.
+
+    @par Example
+    @code
+    url_view u( "http://user%20name@example.com" );
+    char buf[64];
+    assert( decode_to( u.encoded_user(), buf, sizeof(buf) ) == "user name" );
+    @endcode
+
+    @par Exception Safety
+
+    Throws @ref too_large if `cap` is less
+    than @ref decoded_size of `s`, and
+    nothing is written.
+
+    @throw invalid_part An escape in `s` is
+    malformed, and nothing is written.
+
+    @return A view of the decoded
+    string within `dest`.
+
+    @param s The percent-encoded string.
+
+    @param dest The buffer to write to.
+
+    @param cap The size of the buffer.
+*/
+BOOST_URL_DECL
+string_view
+decode_to(
+    string_view s,
+    char* dest,
+    std::size_t cap);
+
+/** Decode a string to an output iterator.
+
+    This function decodes the percent-encoded
+    string `s`, writing each character to the
+    output iterator.
+
+    @par Exception Safety
+
+    Throws only if the iterator throws, or
+    as below.
+
+    @throw invalid_part An escape in `s` is
+    malformed, and nothing is written.
+
+    @return The output iterator one past
+    the last character written.
+
+    @param s The percent-encoded string.
+
+    @param out The output iterator to write to.
+*/
+template<class OutputIt>
+OutputIt
+decode_to(
+    string_view s,
+    OutputIt out);
+
+/** Append a decoded string to a `std::basic_string`.
+
+    This function decodes the percent-encoded
+    string `s`, appending the result to `dest`.
+    The string grows by exactly @ref decoded_size
+    characters, so no memory is allocated when
+    `dest` has enough capacity.
+
+    @par Exception Safety
+
+    Strong guarantee.
+    Calls to allocate may throw.
+
+    @throw invalid_part An escape in `s`
+    is malformed.
+
+    @param s The percent-encoded string.
+
+    @param dest The string to append to.
+*/
+template<class Allocator>
+void
+append_decoded(
+    string_view s,
+    std::basic_string<char,
+        std::char_traits<char>,
+            Allocator>& dest);
+
+} // urls
+} // boost
+
+#include <boost/url/impl/decode.hpp>
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/decode.ipp>
+#endif
+
+#endif
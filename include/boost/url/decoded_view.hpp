@@ -0,0 +1,359 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_DECODED_VIEW_HPP
+#define BOOST_URL_DECODED_VIEW_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/detail/char_type.hpp>
+#include <cstddef>
+#include <iterator>
+
+namespace boost {
+namespace urls {
+
+/** A view of a percent-encoded string as its decoded characters.
+
+    This read-only view refers to an encoded
+    string, such as the value returned by any of
+    the `encoded_` accessors of @ref url_view,
+    @ref url_base, or their segment and parameter
+    containers, and presents it as the sequence
+    of characters obtained by decoding it.
+
+    Characters are decoded as they are visited.
+    Iteration, comparison and hashing never
+    allocate memory, and the view does not own
+    the string it refers to.
+
+    @par Example
+    @code
+    url_view u( "/files/my%20report.pdf" );
+    decoded_view d( u.encoded_path() );
+    assert( d.starts_with( "/files/" ) );
+    assert( d.ends_with( " report.pdf" ) );
+    assert( d == "/files/my report.pdf" );
+    @endcode
+*/
+class decoded_view
+{
+    string_view s_;
+
+public:
+    class iterator;
+
+    /// The type of iterator
+    using const_iterator = iterator;
+
+    /// The type of character
+    using value_type = char;
+
+    /// The type of a decoded character
+    using reference = char;
+
+    /// An unsigned integer type
+    using size_type = std::size_t;
+
+    /// A signed integer type
+    using difference_type = std::ptrdiff_t;
+
+    /** Constructor.
+
+        Default constructed views
+        refer to an empty string.
+    */
+    decoded_view() = default;
+
+    /** Constructor.
+
+        @par Precondition
+        `s` is a valid percent-encoded string.
+
+        @param s The encoded string,
+        which is not copied.
+    */
+    explicit
+    decoded_view(
+        string_view s) noexcept
+        : s_(s)
+    {
+    }
+
+    /** Return the encoded string.
+    */
+    string_view
+    encoded() const noexcept
+    {
+        return s_;
+    }
+
+    /** Return true if there are no characters.
+    */
+    bool
+    empty() const noexcept
+    {
+        return s_.empty();
+    }
+
+    /** Return the number of decoded characters.
+
+        This function takes time
+        linear in the encoded size.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return detail::pct_encoding::
+            raw_decoded_size(s_);
+    }
+
+    /** Return an iterator to the first decoded character.
+    */
+    inline
+    iterator
+    begin() const noexcept;
+
+    /** Return an iterator to one past the last decoded character.
+    */
+    inline
+    iterator
+    end() const noexcept;
+
+    /** Compare the decoded characters with a string.
+
+        Characters compare as unsigned values.
+
+        @return A negative value, zero, or a
+        positive value if the decoded string is
+        less than, equal to, or greater than `s`.
+    */
+    BOOST_URL_DECL
+    int
+    compare(
+        string_view s) const noexcept;
+
+    /** Compare the decoded characters with another view.
+    */
+    BOOST_URL_DECL
+    int
+    compare(
+        decoded_view other) const noexcept;
+
+    /** Compare the decoded characters with a string, ignoring case.
+
+        ASCII letters are compared as
+        if they were lower case.
+    */
+    BOOST_URL_DECL
+    int
+    compare_icase(
+        string_view s) const noexcept;
+
+    /** Return true if the decoded characters start with a string.
+    */
+    BOOST_URL_DECL
+    bool
+    starts_with(
+        string_view s) const noexcept;
+
+    /** Return true if the decoded characters start with a string, ignoring case.
+    */
+    BOOST_URL_DECL
+    bool
+    starts_with_icase(
+        string_view s) const noexcept;
+
+    /** Return true if the decoded characters end with a string.
+    */
+    BOOST_URL_DECL
+    bool
+    ends_with(
+        string_view s) const noexcept;
+
+    /** Return true if the decoded characters end with a string, ignoring case.
+    */
+    BOOST_URL_DECL
+    bool
+    ends_with_icase(
+        string_view s) const noexcept;
+
+    /** Return a hash of the decoded characters.
+
+        The value is the 32 or 64 bit FNV-1a hash
+        of the decoded characters, according to the
+        size of `std::size_t`. It does not depend on
+        how the characters were encoded, or on the
+        process, so equal strings hash equally
+        everywhere.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    hash() const noexcept;
+
+    /** Return a hash of the decoded characters, ignoring case.
+
+        Views which compare equal with
+        @ref compare_icase hash equally.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    hash_icase() const noexcept;
+
+    friend
+    bool
+    operator==(
+        decoded_view a,
+        decoded_view b) noexcept
+    {
+        return a.compare(b) == 0;
+    }
+
+    friend
+    bool
+    operator!=(
+        decoded_view a,
+        decoded_view b) noexcept
+    {
+        return a.compare(b) != 0;
+    }
+
+    friend
+    bool
+    operator<(
+        decoded_view a,
+        decoded_view b) noexcept
+    {
+        return a.compare(b) < 0;
+    }
+
+    friend
+    bool
+    operator==(
+        decoded_view a,
+        string_view b) noexcept
+    {
+        return a.compare(b) == 0;
+    }
+
+    friend
+    bool
+    operator!=(
+        decoded_view a,
+        string_view b) noexcept
+    {
+        return a.compare(b) != 0;
+    }
+
+    friend
+    bool
+    operator==(
+        string_view a,
+        decoded_view b) noexcept
+    {
+        return b.compare(a) == 0;
+    }
+
+    friend
+    bool
+    operator!=(
+        string_view a,
+        decoded_view b) noexcept
+    {
+        return b.compare(a) != 0;
+    }
+};
+
+//----------------------------------------------------------
+
+/** An iterator over the decoded characters of a @ref decoded_view.
+*/
+class decoded_view::iterator
+{
+    char const* p_ = nullptr;
+
+    friend class decoded_view;
+
+    explicit
+    iterator(
+        char const* p) noexcept
+        : p_(p)
+    {
+    }
+
+public:
+    /// Characters are decoded on access and
+    /// returned by value, as a proxy reference,
+    /// like the iterators of `std::vector<bool>`.
+    /// The traversal is forward only.
+    using iterator_category =
+        std::forward_iterator_tag;
+
+    using value_type = char;
+
+    /// Characters are returned by value
+    using reference = char;
+
+    using pointer = void;
+
+    using difference_type =
+        std::ptrdiff_t;
+
+    iterator() = default;
+
+    char
+    operator*() const noexcept
+    {
+        if(*p_ != '%')
+            return *p_;
+        return static_cast<char>(
+            (static_cast<unsigned char>(
+                detail::hex_digit(p_[1])) << 4) +
+            static_cast<unsigned char>(
+                detail::hex_digit(p_[2])));
+    }
+
+    iterator&
+    operator++() noexcept
+    {
+        p_ += (*p_ == '%') ? 3 : 1;
+        return *this;
+    }
+
+    iterator
+    operator++(int) noexcept
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool
+    operator==(
+        iterator other) const noexcept
+    {
+        return p_ == other.p_;
+    }
+
+    bool
+    operator!=(
+        iterator other) const noexcept
+    {
+        return p_ != other.p_;
+    }
+};
+
+} // urls
+} // boost
+
+#include <boost/url/impl/decoded_view.hpp>
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/decoded_view.ipp>
+#endif
+
+#endif
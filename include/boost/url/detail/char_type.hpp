@@ -12,12 +12,189 @@
 
 #include <boost/url/config.hpp>
 #include <boost/url/error.hpp>
+#include <boost/url/detail/error_value.hpp>
+#include <boost/url/detail/simd.hpp>
 #include <cstdint>
 
 namespace boost {
 namespace urls {
 namespace detail {
 
+// Character tables are static members of a class
+// template so they can be used in constant
+// expressions, and so that every translation unit
+// shares one copy.
+template<class = void>
+struct char_tables
+{
+    static constexpr char hex_digit[] =
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" //   0...15
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" //  16...31
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" //  32...47
+        "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\xff\xff\xff\xff\xff\xff" //  48...63
+        "\xff\x0a\x0b\x0c\x0d\x0e\x0f\xff\xff\xff\xff\xff\xff\xff\xff\xff" //  64...79
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" //  80...95
+        "\xff\x0a\x0b\x0c\x0d\x0e\x0f\xff\xff\xff\xff\xff\xff\xff\xff\xff" //  96..111
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 112..127
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 128..143
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 144..159
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 160..175
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 176..191
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 192..207
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 208..223
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 224..239
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 240..255
+        ;
+
+    // [A-Za-z.+-]
+    static constexpr char scheme_char[] =
+        "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" //   0...31
+        "\0\0\0\0\0\0\0\0\0\0\0\1\0\1\1\0" "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" //  32...63
+        "\0\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\0\0\0\0\0" //  64...95
+        "\0\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\0\0\0\0\0" //  96..127
+        "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" // 128..159
+        "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" // 160..191
+        "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" // 192..223
+        "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" // 224..255
+        ;
+
+    // unreserved / subdelims
+    static constexpr char reg_name[] =
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" //   0...31
+        "\3\1\3\3\1\3\1\1\1\1\1\1\1\1\1\3" "\1\1\1\1\1\1\1\1\1\1\3\1\3\1\3\3" //  32...63
+        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\3\1" //  64...95
+        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1\3" //  96..127
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 128..159
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 160..191
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 192..223
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 224..255
+        ;
+
+    // unreserved / subdelims / ':'
+    static constexpr char userinfo[] =
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" //   0...31
+        "\3\1\3\3\1\3\1\1\1\1\1\1\1\1\1\3" "\1\1\1\1\1\1\1\1\1\1\1\1\3\1\3\3" //  32...63
+        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\3\1" //  64...95
+        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1\3" //  96..127
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 128..159
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 160..191
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 192..223
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 224..255
+        ;
+
+    // unreserved / subdelims / ':' / '@'
+    static constexpr char pchar[] =
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" //   0...31
+        "\3\1\3\3\1\3\1\1\1\1\1\1\1\1\1\3" "\1\1\1\1\1\1\1\1\1\1\1\1\3\1\3\3" //  32...63
+        "\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\3\1" //  64...95
+        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1\3" //  96..127
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 128..159
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 160..191
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 192..223
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 224..255
+        ;
+
+    // unreserved / subdelims / '@'
+    static constexpr char pchar_nc[] =
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" //   0...31
+        "\3\1\3\3\1\3\1\1\1\1\1\1\1\1\1\3" "\1\1\1\1\1\1\1\1\1\1\3\1\3\1\3\3" //  32...63
+        "\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\3\1" //  64...95
+        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1\3" //  96..127
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 128..159
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 160..191
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 192..223
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 224..255
+        ;
+
+    // unreserved / subdelims / ':' / '@' / '/' / '?'
+    static constexpr char frag[] =
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" //   0...31
+        "\3\1\3\3\1\3\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\1\3\1\3\1" //  32...63
+        "\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\3\1" //  64...95
+        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1\3" //  96..127
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 128..159
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 160..191
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 192..223
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 224..255
+        ;
+
+    // frag_pct_set() minus '=' and '&'
+    static constexpr char qkey[] =
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" //   0...31
+        "\3\1\3\3\1\3\3\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1" //  32...63
+        "\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\3\1" //  64...95
+        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1\3" //  96..127
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 128..159
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 160..191
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 192..223
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 224..255
+        ;
+
+    // frag_pct_set minus '&'
+    static constexpr char qval[] =
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" //   0...31
+        "\3\1\3\3\1\3\3\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\1\3\1\3\1" //  32...63
+        "\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\3\1" //  64...95
+        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1\3" //  96..127
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 128..159
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 160..191
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 192..223
+        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 224..255
+        ;
+
+    // The sets above for the vector encoder.
+    // Bit h of entry n is set when the
+    // character 16 * h + n is in the set.
+    static constexpr char reg_name_nib[] =
+        "\xa8\xfc\xf8\xf8\xfc\xf8\xfc\xfc\xfc\xfc\xf4\x5c\x54\x5c\xd4\x70";
+    static constexpr char userinfo_nib[] =
+        "\xa8\xfc\xf8\xf8\xfc\xf8\xfc\xfc\xfc\xfc\xfc\x5c\x54\x5c\xd4\x70";
+    static constexpr char pchar_nib[] =
+        "\xb8\xfc\xf8\xf8\xfc\xf8\xfc\xfc\xfc\xfc\xfc\x5c\x54\x5c\xd4\x70";
+    static constexpr char pchar_nc_nib[] =
+        "\xb8\xfc\xf8\xf8\xfc\xf8\xfc\xfc\xfc\xfc\xf4\x5c\x54\x5c\xd4\x70";
+    static constexpr char frag_nib[] =
+        "\xb8\xfc\xf8\xf8\xfc\xf8\xfc\xfc\xfc\xfc\xfc\x5c\x54\x5c\xd4\x7c";
+    static constexpr char qkey_nib[] =
+        "\xb8\xfc\xf8\xf8\xfc\xf8\xf8\xfc\xfc\xfc\xfc\x5c\x54\x54\xd4\x7c";
+    static constexpr char qval_nib[] =
+        "\xb8\xfc\xf8\xf8\xfc\xf8\xf8\xfc\xfc\xfc\xfc\x5c\x54\x5c\xd4\x7c";
+};
+
+template<class T>
+constexpr char char_tables<T>::hex_digit[];
+template<class T>
+constexpr char char_tables<T>::scheme_char[];
+template<class T>
+constexpr char char_tables<T>::reg_name[];
+template<class T>
+constexpr char char_tables<T>::userinfo[];
+template<class T>
+constexpr char char_tables<T>::pchar[];
+template<class T>
+constexpr char char_tables<T>::pchar_nc[];
+template<class T>
+constexpr char char_tables<T>::frag[];
+template<class T>
+constexpr char char_tables<T>::qkey[];
+template<class T>
+constexpr char char_tables<T>::qval[];
+template<class T>
+constexpr char char_tables<T>::reg_name_nib[];
+template<class T>
+constexpr char char_tables<T>::userinfo_nib[];
+template<class T>
+constexpr char char_tables<T>::pchar_nib[];
+template<class T>
+constexpr char char_tables<T>::pchar_nc_nib[];
+template<class T>
+constexpr char char_tables<T>::frag_nib[];
+template<class T>
+constexpr char char_tables<T>::qkey_nib[];
+template<class T>
+constexpr char char_tables<T>::qval_nib[];
+
+BOOST_URL_CONSTEXPR
 inline
 char
 to_lower(char c) noexcept
@@ -26,9 +203,10 @@ to_lower(char c) noexcept
         static_cast<unsigned char>(c - 65);
     if(u > 25)
         return c;
-    return 'a' + c;
+    return static_cast<char>('a' + u);
 }
 
+BOOST_URL_CONSTEXPR
 inline
 bool
 is_alpha(
@@ -48,48 +226,36 @@ is_alpha(
     return false;
 }
 
+BOOST_URL_CONSTEXPR
+inline
+bool
+is_unreserved(
+    char c) noexcept
+{
+    return
+        is_alpha(c) ||
+        (c >= '0' && c <= '9') ||
+        c == '-' || c == '.' ||
+        c == '_' || c == '~';
+}
+
+BOOST_URL_CONSTEXPR
 inline
 char
 hex_digit(char c) noexcept
 {
-    static constexpr char tab[] =
-        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" //   0...15
-        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" //  16...31
-        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" //  32...47
-        "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\xff\xff\xff\xff\xff\xff" //  48...63
-        "\xff\x0a\x0b\x0c\x0d\x0e\x0f\xff\xff\xff\xff\xff\xff\xff\xff\xff" //  64...79
-        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" //  80...95
-        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" //  96..111
-        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 112..127
-        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 128..143
-        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 144..159
-        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 160..175
-        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 176..191
-        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 192..207
-        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 208..223
-        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 224..239
-        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff" // 240..255
-        ;
-    return tab[static_cast<unsigned char>(c)];
+    return char_tables<>::hex_digit[
+        static_cast<unsigned char>(c)];
 }
 
+BOOST_URL_CONSTEXPR
 inline
 bool
 is_scheme_char(
     char c) noexcept
 {
-    // [A-Za-z.+-]
-    static constexpr char tab[] =
-        "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" //   0...31
-        "\0\0\0\0\0\0\0\0\0\0\0\1\0\1\1\0" "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" //  32...63
-        "\0\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\0\0\0\0\0" //  64...95
-        "\0\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\0\0\0\0\0" //  96..127
-        "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" // 128..159
-        "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" // 160..191
-        "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" // 192..223
-        "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" // 224..255
-        ;
-    return tab[static_cast<unsigned char>(c)] != 0;
+    return char_tables<>::scheme_char[
+        static_cast<unsigned char>(c)] != 0;
 }
 
 //----------------------------------------------------------
@@ -97,6 +263,7 @@ is_scheme_char(
 class pct_encoding
 {
     char const* tab_;
+    char const* nib_;
 
     char
     needed(char c) const noexcept
@@ -121,13 +288,16 @@ public:
     pct_encoding(pct_encoding const&) = default;
     pct_encoding& operator=(pct_encoding const&) = default;
 
-    explicit
+    constexpr
     pct_encoding(
-        char const* tab) noexcept
+        char const* tab,
+        char const* nib) noexcept
         : tab_(tab)
+        , nib_(nib)
     {
     }
 
+    BOOST_URL_CONSTEXPR
     char
     is_special(char c) const noexcept
     {
@@ -136,11 +306,12 @@ public:
     }
 
     static
+    BOOST_URL_CONSTEXPR
     void
     check_escape(
         char const* p,
         char const* end,
-        error_code& ec) noexcept
+        error_value& ec) noexcept
     {
         if(end - p < 2)
         {
@@ -165,6 +336,12 @@ public:
         auto const p1 = p + s.size();
         while(p < p1)
         {
+            auto const k =
+                count_unreserved(p, p1);
+            p += k;
+            n += k;
+            if(p == p1)
+                break;
             auto c = *p++;
             if(c != '%')
             {
@@ -176,9 +353,13 @@ public:
                 ++n;
                 continue;
             }
-            check_escape(p, p1, ec);
-            if(ec)
+            error_value e;
+            check_escape(p, p1, e);
+            if(e)
+            {
+                ec = e;
                 break;
+            }
             p += 2;
             ++n;
         }
@@ -193,6 +374,14 @@ public:
         return !ec;
     }
 
+    void
+    validate(
+        string_view s,
+        error_code& ec) const noexcept
+    {
+        (void) decoded_size(s, ec);
+    }
+
     string_view
     validate(string_view s) const
     {
@@ -201,21 +390,34 @@ public:
         return s;
     }
 
+    // Sets pct to true if an
+    // escape was seen, else unchanged
+    BOOST_URL_CONSTEXPR
     char const*
     parse(
         char const* const begin,
         char const* const end,
-        error_code& ec) const noexcept
+        error_value& ec,
+        bool& pct) const noexcept
     {
         auto p = begin;
         while(p < end)
         {
+            // skip whole blocks of
+            // unreserved characters
+            if(! BOOST_URL_IS_CONSTANT_EVALUATED())
+            {
+                p += count_unreserved(p, end);
+                if(p == end)
+                    break;
+            }
             if(*p == '%')
             {
                 check_escape(
                     p + 1, end, ec);
                 if(ec)
                     return p;
+                pct = true;
                 p += 3;
                 continue;
             }
@@ -226,68 +428,124 @@ public:
         return p;
     }
 
-    // unchecked
+    BOOST_URL_CONSTEXPR
+    char const*
+    parse(
+        char const* const begin,
+        char const* const end,
+        error_value& ec) const noexcept
+    {
+        bool pct = false;
+        return parse(begin, end, ec, pct);
+    }
+
+    char const*
+    parse(
+        char const* const begin,
+        char const* const end,
+        error_code& ec) const noexcept
+    {
+        error_value e;
+        auto const p =
+            parse(begin, end, e);
+        if(e)
+            ec = e;
+        return p;
+    }
+
+    // Precondition: every '%' in s
+    // starts a complete escape
     static
     std::size_t
     raw_decoded_size(
         string_view s) noexcept
+    {
+        // each escape is three
+        // characters decoding to one
+        auto const n = count_pct(
+            s.data(), s.data() + s.size());
+        BOOST_ASSERT(3 * n <= s.size());
+        return s.size() - 2 * n;
+    }
+
+    // Returns the decoded size of s, checking
+    // only the escapes, so that a string of
+    // any character set is accepted. Sets
+    // ec and returns 0 if an escape is
+    // malformed.
+    static
+    std::size_t
+    checked_decoded_size(
+        string_view s,
+        error_code& ec) noexcept
     {
         std::size_t n = 0;
         auto p = s.data();
-        auto const p1 = p + s.size();
-        while(p < p1)
+        auto const end = p + s.size();
+        while(p < end)
         {
-            auto c = *p;
-            if(c != '%')
-            {
-                ++p;
-                ++n;
+            if(*p++ != '%')
                 continue;
+            error_value e;
+            check_escape(p, end, e);
+            if(e)
+            {
+                ec = e;
+                return 0;
             }
-            p += 3;
+            p += 2;
             ++n;
         }
-        return n;
+        ec = {};
+        return s.size() - 2 * n;
     }
 
-    // Precondition: s is a valid encoded string
+    // Precondition: s is a valid encoded string,
+    // and dest has room for raw_decoded_size(s)
     static
     char*
     decode(
         char* dest,
         string_view s) noexcept
     {
-        auto p = s.begin();
-        auto const p1 = s.end();
-        while(p < p1)
-        {
-            if(*p != '%')
-            {
-                *dest++ = *p++;
-                continue;
-            }
-            *dest++ = static_cast<char>(
-                (static_cast<unsigned char>(
-                    hex_digit(p[1])) << 4) +
-                static_cast<unsigned char>(
-                    hex_digit(p[2])));
-            p += 3;
-        }
-        return dest;
+        return decode_unchecked(
+            dest, dest + raw_decoded_size(s),
+            s.data(), s.data() + s.size());
+    }
+
+    // Precondition: s is a valid encoded string,
+    // and dest has room for s.size() characters.
+    //
+    // Computes the size and decodes in one pass,
+    // returning one past the last byte written.
+    static
+    char*
+    decode_upper_bound(
+        char* dest,
+        string_view s) noexcept
+    {
+        return decode_unchecked(
+            dest, dest + s.size(),
+            s.data(), s.data() + s.size());
     }
 
     std::size_t
     encoded_size(
         string_view s) const noexcept
     {
-        std::size_t n = 0;
         auto p = s.data();
         auto const p1 = p + s.size();
+        // each special becomes three
+        std::size_t n = 2 * count_special(
+            p, p1, nib_);
+        n += p - s.data();
         while(p < p1)
             n += needed(*p++);
         return n;
     }
 
+    // Returns the number of
+    // characters written
     std::size_t
     encode(
         char* dest,
@@ -296,6 +554,8 @@ public:
         auto p = s.data();
         auto const p1 = p + s.size();
         auto const d0 = dest;
+        dest = encode_blocks(
+            dest, p, p1, nib_);
         while(p < p1)
         {
             if(! is_special(*p))
@@ -314,43 +574,28 @@ public:
 
 //----------------------------------------------------------
 
+BOOST_URL_CONSTEXPR
 inline
 pct_encoding
 reg_name_pct_set() noexcept
 {
-    // unreserved / subdelims
-    static constexpr char tab[] =
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" //   0...31
-        "\3\1\3\3\1\3\1\1\1\1\1\1\1\1\1\3" "\1\1\1\1\1\1\1\1\1\1\3\1\3\1\3\3" //  32...63
-        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\3\1" //  64...95
-        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1\3" //  96..127
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 128..159
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 160..191
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 192..223
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 224..255
-        ;
-    return pct_encoding(tab);
+    return pct_encoding(
+        char_tables<>::reg_name,
+        char_tables<>::reg_name_nib);
 }
 
+BOOST_URL_CONSTEXPR
 inline
 pct_encoding
 userinfo_pct_set() noexcept
 {
-    // unreserved / subdelims / ':'
-    static constexpr char tab[] =
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" //   0...31
-        "\3\1\3\3\1\3\1\1\1\1\1\1\1\1\1\3" "\1\1\1\1\1\1\1\1\1\1\1\1\3\1\3\3" //  32...63
-        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\3\1" //  64...95
-        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1\3" //  96..127
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 128..159
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 160..191
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 192..223
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 224..255
-        ;
-    return pct_encoding(tab);
+    return pct_encoding(
+        char_tables<>::userinfo,
+        char_tables<>::userinfo_nib);
 }
 
 // userinfo_pct_set without ':'
+BOOST_URL_CONSTEXPR
 inline
 pct_encoding
 userinfo_nc_pct_set() noexcept
@@ -358,96 +603,58 @@ userinfo_nc_pct_set() noexcept
     return reg_name_pct_set();
 }
 
+BOOST_URL_CONSTEXPR
 inline
 pct_encoding
 pchar_pct_set() noexcept
 {
-    // unreserved / subdelims / ':' / '@'
-    static constexpr char tab[] =
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" //   0...31
-        "\3\1\3\3\1\3\1\1\1\1\1\1\1\1\1\3" "\1\1\1\1\1\1\1\1\1\1\1\1\3\1\3\3" //  32...63
-        "\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\3\1" //  64...95
-        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1\3" //  96..127
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 128..159
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 160..191
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 192..223
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 224..255
-        ;
-    return pct_encoding(tab);
+    return pct_encoding(
+        char_tables<>::pchar,
+        char_tables<>::pchar_nib);
 }
 
+BOOST_URL_CONSTEXPR
 inline
 pct_encoding
 pchar_nc_pct_set() noexcept
 {
-    // unreserved / subdelims / '@'
-    static constexpr char tab[] =
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" //   0...31
-        "\3\1\3\3\1\3\1\1\1\1\1\1\1\1\1\3" "\1\1\1\1\1\1\1\1\1\1\3\1\3\1\3\3" //  32...63
-        "\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\3\1" //  64...95
-        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1\3" //  96..127
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 128..159
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 160..191
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 192..223
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 224..255
-        ;
-    return pct_encoding(tab);
+    return pct_encoding(
+        char_tables<>::pchar_nc,
+        char_tables<>::pchar_nc_nib);
 }
 
+BOOST_URL_CONSTEXPR
 inline
 pct_encoding
 frag_pct_set() noexcept
 {
-    // unreserved / subdelims / ':' / '@' / '/' / '?'
-    static constexpr char tab[] =
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" //   0...31
-        "\3\1\3\3\1\3\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\1\3\1\3\1" //  32...63
-        "\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\3\1" //  64...95
-        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1\3" //  96..127
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 128..159
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 160..191
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 192..223
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 224..255
-        ;
-    return pct_encoding(tab);
+    return pct_encoding(
+        char_tables<>::frag,
+        char_tables<>::frag_nib);
 }
+
+BOOST_URL_CONSTEXPR
 inline
 pct_encoding
 qkey_pct_set() noexcept
 {
-    // frag_pct_set() minus '='
-    static constexpr char tab[] =
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" //   0...31
-        "\3\1\3\3\1\3\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1" //  32...63
-        "\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\3\1" //  64...95
-        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1\3" //  96..127
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 128..159
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 160..191
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 192..223
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 224..255
-        ;
-    return pct_encoding(tab);
+    return pct_encoding(
+        char_tables<>::qkey,
+        char_tables<>::qkey_nib);
 }
 
+BOOST_URL_CONSTEXPR
 inline
 pct_encoding
 qval_pct_set() noexcept
 {
-    // frag_pct_set minus '&'
-    static constexpr char tab[] =
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" //   0...31
-        "\3\1\3\3\1\3\3\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\1\3\1\3\1" //  32...63
-        "\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\3\1" //  64...95
-        "\3\1\1\1\1\1\1\1\1\1\1\1\1\1\1\1" "\1\1\1\1\1\1\1\1\1\1\1\3\3\3\1\3" //  96..127
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 128..159
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 160..191
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 192..223
-        "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" "\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3\3" // 224..255
-        ;
-    return pct_encoding(tab);
+    return pct_encoding(
+        char_tables<>::qval,
+        char_tables<>::qval_nib);
 }
 
 // DEPRECATED
+BOOST_URL_CONSTEXPR
 inline
 pct_encoding
 query_pct_set() noexcept
@@ -462,13 +669,40 @@ decode(
     Allocator const& a)
 {
     string_type<Allocator> s(a);
-    s.resize(
-        detail::pct_encoding::
-            raw_decoded_size(sv));
-    pct_encoding::decode(&s[0], sv);
+    if(sv.empty())
+        return s;
+    // the decoded string is never
+    // longer than the encoded one
+    s.resize(sv.size());
+    auto const end = pct_encoding::
+        decode_upper_bound(&s[0], sv);
+    s.resize(end - &s[0]);
     return s;
 }
 
+// Returns s if it has no escapes, else
+// decodes s into dest and returns that.
+// pct is false when s is known to have
+// no escapes, skipping the search.
+inline
+string_view
+decode_view(
+    string_view s,
+    bool pct,
+    char* dest,
+    std::size_t cap)
+{
+    if( ! pct ||
+        s.find('%') == string_view::npos)
+        return s;
+    auto const n = pct_encoding::
+        raw_decoded_size(s);
+    if(n > cap)
+        too_large::raise();
+    pct_encoding::decode(dest, s);
+    return string_view(dest, n);
+}
+
 // returns true if decode(encoded)==match
 inline
 bool
@@ -507,6 +741,70 @@ key_equal(
     }
 }
 
+// FNV-1a
+struct key_hasher
+{
+#if BOOST_URL_ARCH == 64
+    static constexpr std::size_t basis =
+        14695981039346656037ULL;
+    static constexpr std::size_t prime =
+        1099511628211ULL;
+#else
+    static constexpr std::size_t basis =
+        2166136261U;
+    static constexpr std::size_t prime =
+        16777619U;
+#endif
+
+    std::size_t h = basis;
+
+    void
+    operator()(char c) noexcept
+    {
+        h = (h ^ static_cast<
+            unsigned char>(c)) * prime;
+    }
+};
+
+// returns the hash of s
+inline
+std::size_t
+key_hash(string_view s) noexcept
+{
+    key_hasher h;
+    for(auto c : s)
+        h(c);
+    return h.h;
+}
+
+// returns key_hash(decode(encoded)),
+// without allocating
+inline
+std::size_t
+encoded_key_hash(
+    string_view encoded) noexcept
+{
+    key_hasher h;
+    auto p = encoded.data();
+    auto const e = p + encoded.size();
+    while(p < e)
+    {
+        if(*p != '%')
+        {
+            h(*p++);
+            continue;
+        }
+        BOOST_ASSERT(e - p >= 3);
+        h(static_cast<char>(
+            (static_cast<unsigned char>(
+                hex_digit(p[1])) << 4) +
+            static_cast<unsigned char>(
+                hex_digit(p[2]))));
+        p += 3;
+    }
+    return h.h;
+}
+
 //----------------------------------------------------------
 
 struct port_string
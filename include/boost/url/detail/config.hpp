@@ -21,6 +21,7 @@
 # include <boost/utility/string_view.hpp>
 #else
 # include <cassert>
+# include <exception>
 # include <optional>
 # include <string_view>
 # include <system_error>
@@ -93,11 +94,20 @@
 #define BOOST_FALLTHROUGH [[fallthrough]]
 #endif
 
+// detect -fno-exceptions when <boost/config.hpp> is not used
+#ifndef BOOST_NO_EXCEPTIONS
+# if !defined(__cpp_exceptions) && \
+     !defined(__EXCEPTIONS) && \
+     !defined(_CPPUNWIND)
+#  define BOOST_NO_EXCEPTIONS
+# endif
+#endif
+
 #ifndef BOOST_THROW_EXCEPTION
 # ifndef BOOST_NO_EXCEPTIONS
 #  define BOOST_THROW_EXCEPTION(x) throw(x)
 # else
-#  define BOOST_THROW_EXCEPTION(x) do{}while(0)
+#  define BOOST_THROW_EXCEPTION(x) ::std::terminate()
 # endif
 #endif
 
@@ -108,6 +118,67 @@
 # endif
 #endif
 
+#ifndef BOOST_URL_NO_SSSE3
+# if defined(BOOST_URL_USE_SSE2) && ( \
+      defined(__SSSE3__) || defined(__AVX__))
+#  define BOOST_URL_USE_SSSE3
+# endif
+#endif
+
+#ifndef BOOST_URL_NO_AVX2
+# if defined(BOOST_URL_USE_SSSE3) && defined(__AVX2__)
+#  define BOOST_URL_USE_AVX2
+# endif
+#endif
+
+// detect __builtin_is_constant_evaluated
+#if defined(__has_builtin)
+# if __has_builtin(__builtin_is_constant_evaluated)
+#  define BOOST_URL_HAS_IS_CONSTANT_EVALUATED
+# endif
+#endif
+#if ! defined(BOOST_URL_HAS_IS_CONSTANT_EVALUATED) && ( \
+    (defined(__GNUC__) && __GNUC__ >= 9) || \
+    (defined(_MSC_VER) && _MSC_VER >= 1925))
+# define BOOST_URL_HAS_IS_CONSTANT_EVALUATED
+#endif
+
+// The parser is constexpr when the compiler has
+// relaxed constexpr (C++14), and the SIMD paths
+// can be skipped during constant evaluation.
+#ifndef BOOST_URL_NO_CONSTEXPR_PARSE
+# if (defined(__cpp_constexpr) && __cpp_constexpr >= 201304L) || \
+     (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L && _MSC_VER >= 1910)
+#  if defined(BOOST_URL_HAS_IS_CONSTANT_EVALUATED) || \
+      ! defined(BOOST_URL_USE_SSE2)
+#   define BOOST_URL_CONSTEXPR_PARSE
+#  endif
+# endif
+#endif
+
+// Outside of a constexpr parser nothing is
+// constant evaluated, and gcc warns that
+// the builtin is always false there.
+#if defined(BOOST_URL_CONSTEXPR_PARSE) && \
+    defined(BOOST_URL_HAS_IS_CONSTANT_EVALUATED)
+# define BOOST_URL_IS_CONSTANT_EVALUATED() \
+    __builtin_is_constant_evaluated()
+#else
+# define BOOST_URL_IS_CONSTANT_EVALUATED() false
+#endif
+
+#ifdef BOOST_URL_CONSTEXPR_PARSE
+# define BOOST_URL_CONSTEXPR constexpr
+# if defined(__cpp_consteval) && __cpp_consteval >= 201811L
+#  define BOOST_URL_CONSTEVAL consteval
+# else
+#  define BOOST_URL_CONSTEVAL constexpr
+# endif
+#else
+# define BOOST_URL_CONSTEXPR
+# define BOOST_URL_CONSTEVAL
+#endif
+
 #ifndef BOOST_URL_STANDALONE
 # if defined(BOOST_URL_DOCS)
 #  define BOOST_URL_DECL
@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_DETAIL_ERROR_VALUE_HPP
+#define BOOST_URL_DETAIL_ERROR_VALUE_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+// An error code used by the parser. Unlike
+// error_code it is a literal type, so parsing
+// can happen in a constant expression.
+class error_value
+{
+    error e_ = static_cast<error>(0);
+
+public:
+    constexpr
+    error_value() = default;
+
+    constexpr
+    error_value(error e) noexcept
+        : e_(e)
+    {
+    }
+
+    constexpr
+    explicit
+    operator bool() const noexcept
+    {
+        return e_ != static_cast<error>(0);
+    }
+
+    constexpr
+    error
+    get() const noexcept
+    {
+        return e_;
+    }
+
+    operator error_code() const noexcept
+    {
+        if(! *this)
+            return {};
+        return make_error_code(e_);
+    }
+
+    friend
+    constexpr
+    bool
+    operator==(
+        error_value v,
+        error e) noexcept
+    {
+        return v.e_ == e;
+    }
+
+    friend
+    constexpr
+    bool
+    operator!=(
+        error_value v,
+        error e) noexcept
+    {
+        return v.e_ != e;
+    }
+};
+
+} // detail
+} // urls
+} // boost
+
+#endif
@@ -11,6 +11,7 @@
 #define BOOST_URL_DETAIL_PARSE_HPP
 
 #include <boost/url/detail/char_type.hpp>
+#include <boost/url/detail/error_value.hpp>
 #include <boost/url/detail/parts.hpp>
 #include <boost/url/error.hpp>
 
@@ -33,7 +34,12 @@ struct parser
     char const* const end_;
     char const* p_;
 
+    // set when an escape is seen,
+    // cleared when a part is marked
+    bool pct_ = false;
+
     explicit
+    BOOST_URL_CONSTEXPR
     parser(
         string_view s) noexcept
         : begin_(s.data())
@@ -42,6 +48,7 @@ struct parser
     {
     }
 
+    BOOST_URL_CONSTEXPR
     parser(
         char const* begin,
         char const* end) noexcept
@@ -51,30 +58,14 @@ struct parser
     {
     }
 
+    BOOST_URL_CONSTEXPR
     bool
     done() const noexcept
     {
         return p_ == end_;
     }
 
-    string_view
-    make_string(
-        char const* begin,
-        char const* end) noexcept
-    {
-        return { begin, static_cast<
-            std::size_t>(end - begin) };
-    }
-
-    bool
-    starts_with(
-        string_view s,
-        string_view prefix) noexcept
-    {
-        return s.substr(
-            0, prefix.size()) == prefix;
-    }
-
+    BOOST_URL_CONSTEXPR
     void
     mark(parts& pt, int id) noexcept
     {
@@ -83,16 +74,26 @@ struct parser
             pt.resize(
                 id_scheme,
                 p_ - begin_);
+            // without the ':'
+            auto n = p_ - begin_;
+            if( n > 0 &&
+                p_[-1] == ':')
+                --n;
+            pt.scheme_id = get_scheme(
+                string_view(begin_, n));
             return;
         }
         pt.resize(id,
             p_ - begin_ -
             pt.offset[id]);
+        pt.set_pct(id, pct_);
+        pct_ = false;
     }
 
     //------------------------------------------------------
 
     // scheme
+    BOOST_URL_CONSTEXPR
     bool
     match_scheme() noexcept
     {
@@ -109,10 +110,11 @@ struct parser
     //------------------------------------------------------
 
     // hier-part
+    BOOST_URL_CONSTEXPR
     void
     parse_hier_part(
         parts& pt,
-        error_code& ec) noexcept
+        error_value& ec) noexcept
     {
         // authority
         if(match_literal("//"))
@@ -143,10 +145,11 @@ struct parser
     }
 
     // relative-part
+    BOOST_URL_CONSTEXPR
     void
     parse_relative_part(
         parts& pt,
-        error_code& ec) noexcept
+        error_value& ec) noexcept
     {
         // authority
         if(match_literal("//"))
@@ -178,60 +181,113 @@ struct parser
 
     //------------------------------------------------------
 
+    BOOST_URL_CONSTEXPR
     void
     parse_authority(
         parts& pt,
-        error_code& ec) noexcept
+        error_value& ec) noexcept
     {
-        auto const p0 = p_;
-        parse_userinfo(pt, ec);
-        if(ec == error::no_match)
-        {
-            // re-parse as host
-            ec = {};
-        }
-        else if(ec)
+        // authority = [ userinfo "@" ] host [ ":" port ]
+        //
+        // The host is scanned first. A reg-name uses
+        // the same characters as a user, so when an
+        // '@' follows, the bytes already scanned become
+        // the user and nothing is scanned twice.
+        mark(pt, id_user);
+        mark(pt, id_password);
+        parse_hostname(pt, ec);
+        if(ec)
+            return;
+        if(p_ == end_)
+            return;
+        if( pt.host == host_type::ipv6 ||
+            pt.host == host_type::ipvfuture)
         {
+            // an ip-literal can't be a user
+            if(*p_ != ':')
+                return;
+            ++p_;
+            std::uint32_t v = 0;
+            match_port(v);
+            mark_port(pt, v, ec);
             return;
         }
-        else if(match_literal("@"))
+        auto const p1 = p_;
+        if(*p_ == ':')
         {
-            // add '@'
-            mark(pt, id_password);
+            ++p_;
+            std::uint32_t v = 0;
+            match_port(v);
+            auto const p2 = p_;
+            if( p_ < end_ &&
+                *p_ != '@' &&
+                *p_ != '/' &&
+                *p_ != '?' &&
+                *p_ != '#')
+            {
+                // not a port, so
+                // it can only be a password
+                auto const e =
+                    userinfo_pct_set();
+                p_ = e.parse(p_, end_, ec, pct_);
+                if(ec)
+                    return;
+            }
+            if( p_ == end_ ||
+                *p_ != '@')
+            {
+                // host ":" port, and
+                // the caller reports
+                // anything after the digits
+                p_ = p2;
+                pct_ = false;
+                mark_port(pt, v, ec);
+                return;
+            }
         }
-        else
+        else if(*p_ != '@')
         {
-            // requires backtracking
-            p_ = p0;
-            mark(pt, id_user);
-            mark(pt, id_password);
+            return;
         }
+        // userinfo "@", the user was
+        // scanned as the host
+        auto const p3 = p_ + 1;
+        auto const pct = pct_;
+        pct_ = pt.has_pct(id_host);
+        p_ = p1;
+        mark(pt, id_user);
+        pct_ = pct;
+        p_ = p3;
+        mark(pt, id_password);
+        pt.host = host_type::none;
         parse_host(pt, ec);
     }
 
+    BOOST_URL_CONSTEXPR
     void
     parse_userinfo(
         parts& pt,
-        error_code& ec) noexcept
+        error_value& ec) noexcept
     {
         auto const p0 = p_;
         auto e = userinfo_nc_pct_set();
-        p_ = e.parse(p0, end_, ec);
+        p_ = e.parse(p0, end_, ec, pct_);
         if(ec)
             return;
         mark(pt, id_user);
         auto const p1 = p_;
         e = userinfo_pct_set();
-        p_ = e.parse(p1, end_, ec);
+        p_ = e.parse(p1, end_, ec, pct_);
         if(ec)
             return;
         mark(pt, id_password);
     }
 
+    BOOST_URL_CONSTEXPR
     void
     parse_host(
         parts& pt,
-        error_code& ec) noexcept
+        error_value& ec) noexcept
     {
         parse_hostname(pt, ec);
         if(ec)
@@ -242,14 +298,16 @@ struct parser
             *p_ != ':')
             return;
         ++p_;
-        match_port();
-        mark(pt, id_port);
+        std::uint32_t v = 0;
+        match_port(v);
+        mark_port(pt, v, ec);
     }
 
+    BOOST_URL_CONSTEXPR
     void
     parse_hostname(
         parts& pt,
-        error_code& ec) noexcept
+        error_value& ec) noexcept
     {
         parse_ip_literal(pt, ec);
         if(ec)
@@ -264,10 +322,11 @@ struct parser
         mark(pt, id_host);
     }
 
+    BOOST_URL_CONSTEXPR
     void
     parse_ip_literal(
         parts& pt,
-        error_code& ec)
+        error_value& ec)
     {
         if(p_ == end_)
         {
@@ -280,7 +339,7 @@ struct parser
             return;
         }
         ++p_;
-        parse_ip_v6(ec);
+        parse_ip_v6(pt.ip, ec);
         if(ec)
             return;
         if(p_ == end_)
@@ -297,34 +356,42 @@ struct parser
         pt.host = host_type::ipv6;
     }
 
+    BOOST_URL_CONSTEXPR
     void
     parse_ipv4_or_domain(
         parts& pt,
-        error_code& ec)
+        error_value& ec)
     {
         auto const p0 = p_;
-        if(match_ip_v4())
+        unsigned char v[4] = {};
+        if(match_ip_v4(v))
         {
             pt.host = host_type::ipv4;
             auto const p1 = p_;
             auto const e =
                 reg_name_pct_set();
-            p_ = e.parse(p_, end_, ec);
+            p_ = e.parse(p_, end_, ec, pct_);
             if(ec)
                 return;
             if(p_ != p1)
+            {
                 pt.host = host_type::name;
+                return;
+            }
+            for(int i = 0; i < 4; ++i)
+                pt.ip[i] = v[i];
             return;
         }
         auto const e =
             reg_name_pct_set();
-        p_ = e.parse(p_, end_, ec);
+        p_ = e.parse(p_, end_, ec, pct_);
         if(ec)
             return;
         if(p_ != p0)
             pt.host = host_type::name;
     }
 
+    BOOST_URL_CONSTEXPR
     short
     match_octet()
     {
@@ -357,258 +424,203 @@ struct parser
         return v;
     }
 
+    // IPv4address, stored in
+    // v[0..3] in network order
+    BOOST_URL_CONSTEXPR
     bool
-    match_ip_v4()
-    {
-        auto a = match_octet();
-        if( a == -1 ||
-            p_ >= end_ ||
-            *p_ != '.')
-            return false;
-        ++p_;
-        auto b = match_octet();
-        if( b == -1 ||
-            p_ >= end_ ||
-            *p_ != '.')
-            return false;
-        ++p_;
-        auto c = match_octet();
-        if( c == -1 ||
-            p_ >= end_ ||
-            *p_ != '.')
-            return false;
-        ++p_;
-        auto d = match_octet();
-        if(d == -1)
-            return false;
-        return true;
-    }
-
-    long
-    parse_word(
-        error_code& ec) noexcept
+    match_ip_v4(
+        unsigned char* v)
     {
-        BOOST_ASSERT(p_ != end_);
-        auto digit =
-            hex_digit(*p_);
-        if(digit == -1)
+        for(int i = 0; i < 4; ++i)
         {
-            ec = error::syntax;
-            return -1;
+            if(i > 0)
+            {
+                if( p_ >= end_ ||
+                    *p_ != '.')
+                    return false;
+                ++p_;
+            }
+            auto const n = match_octet();
+            if(n == -1)
+                return false;
+            v[i] = static_cast<
+                unsigned char>(n);
         }
-        long v = digit;
-        ++p_;
-
-        if(p_ == end_)
-            return v;
-        digit =
-            hex_digit(*p_);
-        if(digit == -1)
-            return v;
-        v = 16 * v + digit;
-        ++p_;
-
-        if(p_ == end_)
-            return v;
-        digit =
-            hex_digit(*p_);
-        if(digit == -1)
-            return v;
-        v = 16 * v + digit;
-        ++p_;
-
-        if(p_ == end_)
-            return v;
-        digit =
-            hex_digit(*p_);
-        if(digit == -1)
-            return v;
-        v = 16 * v + digit;
-        ++p_;
-
-        return v;
-    }
-
-    // return `true` if the hex
-    // word could be 0..255 if
-    // interpreted as decimal
-    bool
-    maybe_octet(long word)
-    {
-        if(word > 0x255)
-            return false;
-        if(((word >>  4) & 0xf) > 9)
-            return false;
-        if((word & 0xf) > 9)
-            return false;
         return true;
     }
 
+    // IPv6address, stored in
+    // v[0..15] in network order
+    BOOST_URL_CONSTEXPR
     void
     parse_ip_v6(
-        error_code& ec) noexcept
+        unsigned char* v,
+        error_value& ec) noexcept
     {
-        if(p_ == end_)
+        unsigned short w[8] = {};
+        int n = 0;      // words parsed
+        int gap = -1;   // where "::" is
+        if( end_ - p_ >= 2 &&
+            p_[0] == ':' &&
+            p_[1] == ':')
         {
-            ec = error::syntax;
-            return;
+            gap = 0;
+            p_ += 2;
         }
-        int n = 8; // words needed
-        bool b = false; // got '::'
-        bool c = false; // need colon
-        long word = 0;
-        for(;;)
+        while(n < 8)
         {
-            if(p_ == end_)
+            if( p_ == end_ ||
+                hex_digit(*p_) == -1)
             {
-                if(b)
+                // only allowed after "::"
+                if(gap == n)
                     break;
-                // not enough words
-                BOOST_ASSERT(n > 0);
                 ec = error::syntax;
                 return;
             }
-            if(*p_ == ':')
+            // h16
+            auto const p0 = p_;
+            unsigned word = 0;
+            for(int i = 0; i < 4 &&
+                p_ < end_; ++i)
             {
+                auto const d =
+                    hex_digit(*p_);
+                if(d == -1)
+                    break;
+                word = 16 * word + d;
                 ++p_;
-                if(p_ == end_)
-                {
-                    ec = error::syntax;
-                    return;
-                }
-                if(*p_ == ':')
-                {
-                    if(b)
-                    {
-                        // two '::'
-                        ec = error::syntax;
-                        return;
-                    }
-                    ++p_;
-                    --n;
-                    if(n == 0)
-                        break;
-                    b = true;
-                    c = false;
-                }
-                else if(c)
-                {
-                    word = parse_word(ec);
-                    if(ec)
-                        return;
-                    --n;
-                    if(n == 0)
-                        break;
-                }
-                else
-                {
-                    // can't start with ':'
-                    ec = error::syntax;
-                    return;
-                }
             }
-            else if(*p_ == '.')
+            if( p_ < end_ &&
+                *p_ == '.')
             {
-                if(! b && n > 1)
-                {
-                    // not enough words
-                    ec = error::syntax;
-                    return;
-                }
-                if(! maybe_octet(word))
+                // ls32 as IPv4address
+                unsigned char v4[4] = {};
+                p_ = p0;
+                if( n > 6 ||
+                    ! match_ip_v4(v4))
                 {
-                    // invalid octet
                     ec = error::syntax;
                     return;
                 }
-                ++p_;
-                auto m = match_octet();
-                if( m == -1)
-                {
-                    ec = error::syntax;
-                    return;
-                }
-                if(p_ >= end_)
-                {
-                    ec = error::syntax;
-                    return;
-                }
-                if(*p_ != '.')
-                {
-                    ec = error::syntax;
-                    return;
-                }
-                ++p_;
-                m = match_octet();
-                if( m == -1)
-                {
-                    ec = error::syntax;
-                    return;
-                }
-                if(p_ >= end_)
-                {
-                    ec = error::syntax;
-                    return;
-                }
-                if(*p_ != '.')
-                {
-                    ec = error::syntax;
-                    return;
-                }
-                ++p_;
-                m = match_octet();
-                if(m == -1)
+                w[n++] = static_cast<
+                    unsigned short>(
+                        v4[0] * 256 + v4[1]);
+                w[n++] = static_cast<
+                    unsigned short>(
+                        v4[2] * 256 + v4[3]);
+                break;
+            }
+            w[n++] = static_cast<
+                unsigned short>(word);
+            if( p_ == end_ ||
+                *p_ != ':')
+                break;
+            if( end_ - p_ >= 2 &&
+                p_[1] == ':')
+            {
+                if(gap != -1)
                 {
+                    // two "::"
                     ec = error::syntax;
                     return;
                 }
-                return;
+                gap = n;
+                p_ += 2;
+                continue;
             }
-            else if(b && hex_digit(*p_) == -1)
+            if(n == 8)
             {
-                // end in "::"
-                break;
+                // trailing ':'
+                ec = error::syntax;
+                return;
             }
-            else if(! c)
+            ++p_;
+        }
+        if(gap == -1)
+        {
+            if(n != 8)
             {
-                word = parse_word(ec);
-                if(ec)
-                    return;
-                --n;
-                if(n == 0)
-                    break;
-                c = true;
+                // not enough words
+                ec = error::syntax;
+                return;
             }
-            else
+        }
+        else
+        {
+            // "::" stands for
+            // at least one word
+            if(n > 7)
             {
-                // ':' divides words
                 ec = error::syntax;
                 return;
             }
+            auto const tail = n - gap;
+            for(int i = 0; i < tail; ++i)
+                w[7 - i] = w[n - 1 - i];
+            for(int i = gap;
+                i < 8 - tail; ++i)
+                w[i] = 0;
+        }
+        for(int i = 0; i < 8; ++i)
+        {
+            v[2 * i] = static_cast<
+                unsigned char>(w[i] >> 8);
+            v[2 * i + 1] = static_cast<
+                unsigned char>(w[i] & 0xff);
         }
     }
 
     // port = *DIGIT
+    //
+    // The value is stored in `v`,
+    // which stays above 65535 once
+    // the port overflows.
+    BOOST_URL_CONSTEXPR
     void
-    match_port() noexcept
+    match_port(
+        std::uint32_t& v) noexcept
     {
+        v = 0;
         while(p_ < end_)
         {
             auto const digit = static_cast<
                 unsigned char>(*p_ - '0');
             if(digit > 9)
                 break;
+            if(v <= 65535)
+                v = 10 * v + digit;
             ++p_;
         }
     }
 
+    // Mark the port matched
+    // with value `v`
+    BOOST_URL_CONSTEXPR
+    void
+    mark_port(
+        parts& pt,
+        std::uint32_t v,
+        error_value& ec) noexcept
+    {
+        if(v > 65535)
+        {
+            ec = error::port_overflow;
+            return;
+        }
+        mark(pt, id_port);
+        pt.port_number = static_cast<
+            std::uint16_t>(v);
+    }
+
     //------------------------------------------------------
 
     // path-abempty
+    BOOST_URL_CONSTEXPR
     void
     parse_path_abempty(
         parts& pt,
-        error_code& ec) noexcept
+        error_value& ec) noexcept
     {
         // *( "/" segment )
         auto const e =
@@ -618,7 +630,7 @@ struct parser
             if(*p_ != '/')
                 break;
             p_ = e.parse(
-                p_ + 1, end_, ec);
+                p_ + 1, end_, ec, pct_);
             if(ec)
                 return;
             ++pt.nseg;
@@ -627,10 +639,11 @@ struct parser
     }
 
     // path-absolute
+    BOOST_URL_CONSTEXPR
     void
     parse_path_absolute(
         parts& pt,
-        error_code& ec) noexcept
+        error_value& ec) noexcept
     {
         // "/" [ segment-nz *( "/" segment ) ]
         if(p_ == end_)
@@ -655,17 +668,19 @@ struct parser
             auto const e =
                 pchar_pct_set();
             // segment-nz
+            auto const p0 = p_;
             p_ = e.parse(
-                p_ + 1, end_, ec);
+                p0, end_, ec, pct_);
             if(ec)
                 return;
-            ++pt.nseg;
+            if(p_ != p0)
+                ++pt.nseg;
             while(p_ < end_)
             {
                 if(*p_ != '/')
                     break;
                 p_ = e.parse(
-                    p_ + 1, end_, ec);
+                    p_ + 1, end_, ec, pct_);
                 if(ec)
                     return;
                 ++pt.nseg;
@@ -675,15 +690,16 @@ struct parser
     }
 
     // path-noscheme
+    BOOST_URL_CONSTEXPR
     void
     parse_path_noscheme(
         parts& pt,
-        error_code& ec) noexcept
+        error_value& ec) noexcept
     {
         auto const p0 = p_;
         auto e =
             pchar_nc_pct_set();
-        p_ = e.parse(p0, end_, ec);
+        p_ = e.parse(p0, end_, ec, pct_);
         if(ec)
             return;
         if(p_ == p0)
@@ -699,7 +715,7 @@ struct parser
             if(*p_ != '/')
                 break;
             p_ = e.parse(
-                p_ + 1, end_, ec);
+                p_ + 1, end_, ec, pct_);
             if(ec)
                 return;
             ++pt.nseg;
@@ -708,15 +724,16 @@ struct parser
     }
 
     // path-rootless
+    BOOST_URL_CONSTEXPR
     void
     parse_path_rootless(
         parts& pt,
-        error_code& ec) noexcept
+        error_value& ec) noexcept
     {
         auto const p0 = p_;
         auto const e =
             pchar_pct_set();
-        p_ = e.parse(p0, end_, ec);
+        p_ = e.parse(p0, end_, ec, pct_);
         if(ec)
             return;
         if(p_ == p0)
@@ -731,7 +748,7 @@ struct parser
             if(*p_ != '/')
                 break;
             p_ = e.parse(
-                p_ + 1, end_, ec);
+                p_ + 1, end_, ec, pct_);
             if(ec)
                 return;
             ++pt.nseg;
@@ -745,10 +762,11 @@ struct parser
     //
     //------------------------------------------------------
 
+    BOOST_URL_CONSTEXPR
     void
     parse_query(
         parts& pt,
-        error_code& ec) noexcept
+        error_value& ec) noexcept
     {
         if(p_ == end_)
             return;
@@ -763,18 +781,24 @@ struct parser
         {
             ++n;
             p_ = ek.parse(
-                p_, end_, ec);
+                p_, end_, ec, pct_);
             if(ec)
                 return;
             if(p_ >= end_)
                 break;
+            if(*p_ == '&')
+            {
+                // key with no value
+                ++p_;
+                continue;
+            }
             if(*p_ != '=')
                 break;
             ++p_;
             if(p_ >= end_)
                 break;
             p_ = ev.parse(
-                p_, end_, ec);
+                p_, end_, ec, pct_);
             if(ec)
                 return;
             if(p_ >= end_)
@@ -793,10 +817,11 @@ struct parser
     //
     //------------------------------------------------------
 
+    BOOST_URL_CONSTEXPR
     void
     parse_fragment(
         parts& pt,
-        error_code& ec) noexcept
+        error_value& ec) noexcept
     {
         if(p_ == end_)
             return;
@@ -806,7 +831,7 @@ struct parser
         auto const e =
             frag_pct_set();
         p_ = e.parse(
-            p_, end_, ec);
+            p_, end_, ec, pct_);
         if(ec)
             return;
         mark(pt, id_frag);
@@ -814,28 +839,98 @@ struct parser
 
     //------------------------------------------------------
 
+    // [ "?" query ] [ "#" fragment ], then
+    // the end of the input
+    BOOST_URL_CONSTEXPR
+    void
+    parse_tail(
+        parts& pt,
+        error_value& ec) noexcept
+    {
+        parse_query(pt, ec);
+        if(ec)
+            return;
+        parse_fragment(pt, ec);
+        if(ec)
+            return;
+        if(! done())
+            ec = error::syntax;
+    }
+
+    //------------------------------------------------------
+
+    BOOST_URL_CONSTEXPR
     bool
     match_literal(
-        string_view s) noexcept
+        char const* s) noexcept
     {
-        if(s.size() > static_cast<
-            std::uintptr_t>(end_ - p_))
-            return false;
-        if(! starts_with(
-            make_string(p_, end_), s))
-            return false;
-        p_ += s.size();
+        auto p = p_;
+        for(; *s; ++s, ++p)
+            if( p == end_ ||
+                *p != *s)
+                return false;
+        p_ = p;
         return true;
     }
 };
 
+// URI
+// Returns the offset where parsing stopped
+BOOST_URL_CONSTEXPR
+inline
+std::size_t
+parse_uri(
+    parts& pt,
+    string_view s,
+    error_value& ec) noexcept
+{
+    parser pr(s);
+    if(! pr.match_scheme())
+    {
+        if(pr.done())
+            ec = error::missing_scheme;
+        else
+            ec = error::bad_scheme_start_char;
+        return 0;
+    }
+    if(! pr.match_literal(":"))
+    {
+        ec = error::bad_scheme_char;
+        return pr.p_ - pr.begin_;
+    }
+    pr.mark(pt, id_scheme);
+    pr.parse_hier_part(pt, ec);
+    if(! ec)
+        pr.parse_tail(pt, ec);
+    return pr.p_ - pr.begin_;
+}
+
+// relative-ref
+// Returns the offset where parsing stopped
+BOOST_URL_CONSTEXPR
+inline
+std::size_t
+parse_relative_ref(
+    parts& pt,
+    string_view s,
+    error_value& ec) noexcept
+{
+    parser pr(s);
+    pr.parse_relative_part(pt, ec);
+    if(! ec)
+        pr.parse_tail(pt, ec);
+    return pr.p_ - pr.begin_;
+}
+
 // URL (a.k.a. URI-reference)
+// Returns the offset where parsing stopped
+BOOST_URL_CONSTEXPR
 inline
-void
+std::size_t
 parse_url(
     parts& pt,
     string_view s,
-    error_code& ec) noexcept
+    error_value& ec) noexcept
 {
     parser pr(s);
     if( pr.match_scheme() &&
@@ -848,25 +943,194 @@ parse_url(
     else
     {
         // rewind
-        ec = {};
         pr.p_ = pr.begin_;
 
         // relative-ref
         pr.parse_relative_part(pt, ec);
-        if(ec)
-            return;
     }
+    if(! ec)
+        pr.parse_tail(pt, ec);
+    return pr.p_ - pr.begin_;
+}
 
+//----------------------------------------------------------
+//
+// HTTP request-target forms
+// https://tools.ietf.org/html/rfc7230#section-5.3
+//
+//----------------------------------------------------------
+
+// origin-form = absolute-path [ "?" query ]
+// Returns the offset where parsing stopped
+BOOST_URL_CONSTEXPR
+inline
+std::size_t
+parse_origin_form(
+    parts& pt,
+    string_view s,
+    error_value& ec) noexcept
+{
+    parser pr(s);
+    // absolute-path = 1*( "/" segment )
+    if( pr.done() ||
+        *pr.p_ != '/')
+    {
+        ec = error::syntax;
+        return 0;
+    }
+    // The path is read as a path-absolute,
+    // which counts segments the same way.
+    // It rejects a path starting with "//",
+    // as a view with no authority can not
+    // hold one.
+    pr.parse_path_absolute(pt, ec);
+    if(ec == error::invalid)
+        ec = error::syntax;
+    if(ec)
+        return pr.p_ - pr.begin_;
     pr.parse_query(pt, ec);
+    if(! ec && ! pr.done())
+        ec = error::syntax;
+    return pr.p_ - pr.begin_;
+}
+
+// absolute-form = absolute-URI
+// Returns the offset where parsing stopped
+BOOST_URL_CONSTEXPR
+inline
+std::size_t
+parse_absolute_form(
+    parts& pt,
+    string_view s,
+    error_value& ec) noexcept
+{
+    parser pr(s);
+    if(! pr.match_scheme())
+    {
+        if(pr.done())
+            ec = error::missing_scheme;
+        else
+            ec = error::bad_scheme_start_char;
+        return 0;
+    }
+    if(! pr.match_literal(":"))
+    {
+        ec = error::bad_scheme_char;
+        return pr.p_ - pr.begin_;
+    }
+    pr.mark(pt, id_scheme);
+    pr.parse_hier_part(pt, ec);
     if(ec)
-        return;
-  
-    pr.parse_fragment(pt, ec);
+        return pr.p_ - pr.begin_;
+    pr.parse_query(pt, ec);
+    if(! ec && ! pr.done())
+        ec = error::syntax;
+    return pr.p_ - pr.begin_;
+}
+
+// authority-form = uri-host ":" port
+// Returns the offset where parsing stopped
+BOOST_URL_CONSTEXPR
+inline
+std::size_t
+parse_authority_form(
+    parts& pt,
+    string_view s,
+    error_value& ec) noexcept
+{
+    // There is no leading "//", so
+    // id_user and id_password are empty.
+    parser pr(s);
+    pr.parse_host(pt, ec);
     if(ec)
-        return;
+        return pr.p_ - pr.begin_;
+    if(pt.length(id_host) == 0)
+    {
+        ec = error::missing_hostname;
+        return 0;
+    }
+    if(! pr.done())
+    {
+        ec = error::syntax;
+        return pr.p_ - pr.begin_;
+    }
+    if(pt.length(id_port) < 2)
+    {
+        // no ':' or no digits
+        ec = error::missing_port;
+        return pr.p_ - pr.begin_;
+    }
+    return pr.p_ - pr.begin_;
+}
 
+// asterisk-form = "*"
+// Returns the offset where parsing stopped
+BOOST_URL_CONSTEXPR
+inline
+std::size_t
+parse_asterisk_form(
+    parts& pt,
+    string_view s,
+    error_value& ec) noexcept
+{
+    parser pr(s);
+    if(! pr.match_literal("*"))
+    {
+        ec = error::syntax;
+        return 0;
+    }
     if(! pr.done())
+    {
         ec = error::syntax;
+        return pr.p_ - pr.begin_;
+    }
+    pr.mark(pt, id_path);
+    pt.nseg = 1;
+    return pr.p_ - pr.begin_;
+}
+
+//----------------------------------------------------------
+
+inline
+std::size_t
+parse_uri(
+    parts& pt,
+    string_view s,
+    error_code& ec) noexcept
+{
+    error_value e;
+    auto const n =
+        parse_uri(pt, s, e);
+    ec = e;
+    return n;
+}
+
+inline
+std::size_t
+parse_relative_ref(
+    parts& pt,
+    string_view s,
+    error_code& ec) noexcept
+{
+    error_value e;
+    auto const n =
+        parse_relative_ref(pt, s, e);
+    ec = e;
+    return n;
+}
+
+inline
+std::size_t
+parse_url(
+    parts& pt,
+    string_view s,
+    error_code& ec) noexcept
+{
+    error_value e;
+    auto const n =
+        parse_url(pt, s, e);
+    ec = e;
+    return n;
 }
 
 // origin
@@ -879,6 +1143,7 @@ parse_origin(
     error_code& ec)
 {
     parser pr(s);
+    error_value e;
     
     // scheme ":" [ "//" authority ]
     if(! pr.match_scheme())
@@ -892,14 +1157,20 @@ parse_origin(
         return;
     }
     pr.mark(pt, id_scheme);
-    pr.parse_hier_part(pt, ec);
+    pr.parse_hier_part(pt, e);
 
     // authority
     if(! pr.match_literal("//"))
+    {
+        ec = e;
         return;
-    pr.parse_authority(pt, ec);
-    if(ec)
+    }
+    pr.parse_authority(pt, e);
+    if(e)
+    {
+        ec = e;
         return;
+    }
     pt.resize(id_user,
         pt.length(id_user) + 1);
 
@@ -911,13 +1182,20 @@ inline
 void
 parse_scheme(
     parts& pt,
-    string_view s)
+    string_view s,
+    error_code& ec) noexcept
 {
     parser pr(s);
     if(! pr.match_scheme())
-        invalid_part::raise();
+    {
+        ec = error::bad_scheme_start_char;
+        return;
+    }
     if(! pr.done())
-        invalid_part::raise();
+    {
+        ec = error::bad_scheme_char;
+        return;
+    }
     pr.mark(pt, id_scheme);
 }
 
@@ -925,45 +1203,45 @@ inline
 void
 parse_authority(
     parts& pt,
-    string_view s)
+    string_view s,
+    error_code& ec) noexcept
 {
     parser pr(s);
-    error_code ec;
-    pr.parse_authority(pt, ec);
-    if(ec)
-        invalid_part::raise();
-    if(! pr.done())
-        invalid_part::raise();
+    error_value e;
+    pr.parse_authority(pt, e);
+    if(! e && ! pr.done())
+        e = error::syntax;
+    ec = e;
 }
 
 inline
 void
 parse_userinfo(
     parts& pt,
-    string_view s)
+    string_view s,
+    error_code& ec) noexcept
 {
     parser pr(s);
-    error_code ec;
-    pr.parse_userinfo(pt, ec);
-    if(ec)
-        invalid_part::raise();
-    if(! pr.done())
-        invalid_part::raise();
+    error_value e;
+    pr.parse_userinfo(pt, e);
+    if(! e && ! pr.done())
+        e = error::bad_userinfo_char;
+    ec = e;
 }
 
 inline
 void
 parse_hostname(
     parts& pt,
-    string_view s)
+    string_view s,
+    error_code& ec) noexcept
 {
     parser pr(s);
-    error_code ec;
-    pr.parse_hostname(pt, ec);
-    if(ec)
-        invalid_part::raise();
-    if(! pr.done())
-        invalid_part::raise();
+    error_value e;
+    pr.parse_hostname(pt, e);
+    if(! e && ! pr.done())
+        e = error::syntax;
+    ec = e;
 }
 
 inline
@@ -973,7 +1251,7 @@ parse_plain_hostname(
     string_view s)
 {
     parser pr(s);
-    error_code ec;
+    error_value ec;
     pr.parse_ip_literal(pt, ec);
     if(ec)
     {
@@ -983,7 +1261,7 @@ parse_plain_hostname(
             return;
         }
         ec = {};
-        if(pr.match_ip_v4())
+        if(pr.match_ip_v4(pt.ip))
         {
             if(pr.done())
             {
@@ -1001,71 +1279,110 @@ parse_plain_hostname(
     pt.host = host_type::name;
 }
 
+// Returns the value of the port
 inline
-void
-match_port(string_view s)
+std::uint16_t
+match_port(
+    string_view s,
+    error_code& ec) noexcept
 {
     parser pr(s);
-    error_code ec;
-    pr.match_port();
+    std::uint32_t v = 0;
+    pr.match_port(v);
     if(! pr.done())
-        invalid_part::raise();
+    {
+        ec = error::bad_port_char;
+        return 0;
+    }
+    if(v > 65535)
+    {
+        ec = error::port_overflow;
+        return 0;
+    }
+    return static_cast<
+        std::uint16_t>(v);
 }
 
+// Returns the number of params in
+// s, which includes the leading '?'
 inline
-void
-match_path_abempty(string_view s)
+std::size_t
+count_params(
+    string_view s) noexcept
 {
     parts pt;
     parser pr(s);
-    error_code ec;
-    pr.parse_path_abempty(pt, ec);
-    if(ec)
-        invalid_part::raise();
-    if(! pr.done())
-        invalid_part::raise();
+    error_value e;
+    pr.parse_query(pt, e);
+    return pt.nparam;
 }
 
+// Returns the number of segments
 inline
-void
-match_path_absolute(string_view s)
+std::size_t
+match_path_abempty(
+    string_view s,
+    error_code& ec) noexcept
 {
     parts pt;
     parser pr(s);
-    error_code ec;
-    pr.parse_path_absolute(pt, ec);
-    if(ec)
-        invalid_part::raise();
-    if(! pr.done())
-        invalid_part::raise();
+    error_value e;
+    pr.parse_path_abempty(pt, e);
+    if(! e && ! pr.done())
+        e = error::syntax;
+    ec = e;
+    return pt.nseg;
 }
 
+// Returns the number of segments
 inline
-void
-match_path_noscheme(string_view s)
+std::size_t
+match_path_absolute(
+    string_view s,
+    error_code& ec) noexcept
 {
     parts pt;
     parser pr(s);
-    error_code ec;
-    pr.parse_path_noscheme(pt, ec);
-    if(ec)
-        invalid_part::raise();
-    if(! pr.done())
-        invalid_part::raise();
+    error_value e;
+    pr.parse_path_absolute(pt, e);
+    if(! e && ! pr.done())
+        e = error::syntax;
+    ec = e;
+    return pt.nseg;
 }
 
+// Returns the number of segments
 inline
-void
-match_path_rootless(string_view s)
+std::size_t
+match_path_noscheme(
+    string_view s,
+    error_code& ec) noexcept
 {
     parts pt;
     parser pr(s);
-    error_code ec;
-    pr.parse_path_rootless(pt, ec);
-    if(ec)
-        invalid_part::raise();
-    if(! pr.done())
-        invalid_part::raise();
+    error_value e;
+    pr.parse_path_noscheme(pt, e);
+    if(! e && ! pr.done())
+        e = error::syntax;
+    ec = e;
+    return pt.nseg;
+}
+
+// Returns the number of segments
+inline
+std::size_t
+match_path_rootless(
+    string_view s,
+    error_code& ec) noexcept
+{
+    parts pt;
+    parser pr(s);
+    error_value e;
+    pr.parse_path_rootless(pt, e);
+    if(! e && ! pr.done())
+        e = error::syntax;
+    ec = e;
+    return pt.nseg;
 }
 
 } // detail
@@ -11,8 +11,11 @@
 #define BOOST_URL_DETAIL_PARTS_HPP
 
 #include <boost/url/host_type.hpp>
+#include <boost/url/scheme.hpp>
 #include <boost/url/detail/char_type.hpp>
 #include <boost/url/error.hpp>
+#include <cstdint>
+#include <cstring>
 
 namespace boost {
 namespace urls {
@@ -40,14 +43,32 @@ struct parts
     std::size_t nseg = 0;
     std::size_t nparam = 0;
     host_type host = host_type::none;
+    urls::scheme scheme_id =
+        urls::scheme::unknown;
 
-    parts()
+    // The value of the port, valid
+    // when the port is not empty
+    std::uint16_t port_number = 0;
+
+    // Bit (1 << id) is set when the
+    // component may contain escapes. A
+    // clear bit means it has none, so the
+    // decoded and encoded strings are equal.
+    unsigned char pct = 0;
+
+    // The address when host is ipv4
+    // (first 4 bytes) or ipv6, in
+    // network byte order.
+    unsigned char ip[16];
+
+    constexpr
+    parts() noexcept
+        : offset{}
+        , ip{}
     {
-        std::fill(
-            offset,
-            offset + id_end + 1, 0);
     }
 
+    BOOST_URL_CONSTEXPR
     std::size_t
     length(
         int id) const noexcept
@@ -56,6 +77,7 @@ struct parts
             offset[id];
     }
 
+    BOOST_URL_CONSTEXPR
     std::size_t
     length(
         int begin,
@@ -67,6 +89,7 @@ struct parts
             offset[begin];
     }
 
+    BOOST_URL_CONSTEXPR
     string_view
     get(int id,
         char const* s) const noexcept
@@ -77,6 +100,7 @@ struct parts
                 offset[id] };
     }
 
+    BOOST_URL_CONSTEXPR
     string_view
     get(int begin,
         int end,
@@ -88,6 +112,7 @@ struct parts
                 offset[begin] };
     }
 
+    BOOST_URL_CONSTEXPR
     void
     resize(
         int id,
@@ -100,6 +125,69 @@ struct parts
             offset[i] += d;
     }
 
+    BOOST_URL_CONSTEXPR
+    bool
+    has_pct(
+        int id) const noexcept
+    {
+        return (pct >> id) & 1;
+    }
+
+    BOOST_URL_CONSTEXPR
+    void
+    set_pct(
+        int id,
+        bool v) noexcept
+    {
+        if(v)
+            pct = static_cast<unsigned char>(
+                pct | (1u << id));
+        else
+            pct = static_cast<unsigned char>(
+                pct & ~(1u << id));
+    }
+
+    // true for an authority-form view,
+    // whose authority has no leading "//"
+    BOOST_URL_CONSTEXPR
+    bool
+    bare_authority() const noexcept
+    {
+        return
+            length(id_user) == 0 &&
+            length(id_user, id_path) != 0;
+    }
+
+    // The length of the components from
+    // begin to end once written by
+    // copy_parts, with the "//" which
+    // a bare authority lacks
+    BOOST_URL_CONSTEXPR
+    std::size_t
+    copied_length(
+        int begin,
+        int end) const noexcept
+    {
+        auto n = length(begin, end);
+        if( begin <= id_user &&
+            id_user < end &&
+            bare_authority())
+            n += 2;
+        return n;
+    }
+
+    // copy the host type and address
+    BOOST_URL_CONSTEXPR
+    void
+    assign_host(
+        parts const& pt) noexcept
+    {
+        host = pt.host;
+        for(int i = 0; i < 16; ++i)
+            ip[i] = pt.ip[i];
+    }
+
+    BOOST_URL_CONSTEXPR
     void
     split(
         int id,
@@ -109,9 +197,64 @@ struct parts
         BOOST_ASSERT(n <= length(id));
         offset[id + 1] = offset[id] +
             static_cast<std::size_t>(n);
+        // the bytes moved to id + 1
+        // are not known to be plain
+        set_pct(id + 1, true);
     }
 };
 
+// Writes the components from begin to end
+// of the string s with parts pt to dest,
+// which is at offset pos of the string
+// described by out, and sets their offsets
+// and escape bits in out. A bare authority
+// gets its "//", so that the result parses
+// the same. Returns the number of chars
+// written, which is pt.copied_length.
+inline
+std::size_t
+copy_parts(
+    parts& out,
+    char* dest,
+    std::size_t pos,
+    parts const& pt,
+    char const* s,
+    int begin,
+    int end) noexcept
+{
+    auto const p0 = pt.offset[begin];
+    std::size_t n0 = pt.length(begin, end);
+    std::size_t add = 0;
+    if( begin <= id_user &&
+        id_user < end &&
+        pt.bare_authority())
+    {
+        // before the authority
+        n0 = pt.offset[id_user] - p0;
+        add = 2;
+    }
+    for(auto i = begin; i < end; ++i)
+    {
+        out.offset[i] = pos +
+            (pt.offset[i] - p0);
+        if(i > id_user)
+            out.offset[i] += add;
+        out.set_pct(i, pt.has_pct(i));
+    }
+    if(n0 > 0)
+        std::memmove(dest, s + p0, n0);
+    if(add == 0)
+        return n0;
+    auto const n1 =
+        pt.offset[end] - pt.offset[id_user];
+    dest[n0] = '/';
+    dest[n0 + 1] = '/';
+    if(n1 > 0)
+        std::memmove(dest + n0 + 2,
+            s + pt.offset[id_user], n1);
+    return n0 + 2 + n1;
+}
+
 } // detail
 } // urls
 } // boost
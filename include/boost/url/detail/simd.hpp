@@ -0,0 +1,561 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_DETAIL_SIMD_HPP
+#define BOOST_URL_DETAIL_SIMD_HPP
+
+#include <boost/url/config.hpp>
+#include <cstddef>
+
+#ifdef BOOST_URL_USE_SSE2
+# include <emmintrin.h>
+# ifdef BOOST_URL_USE_SSSE3
+#  include <tmmintrin.h>
+# endif
+# ifdef BOOST_URL_USE_AVX2
+#  include <immintrin.h>
+# endif
+# ifdef _MSC_VER
+#  include <intrin.h>
+# endif
+#endif
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+#ifdef BOOST_URL_USE_SSE2
+
+// Returns the index of the lowest set bit.
+// Precondition: mask != 0
+inline
+unsigned
+ctz(unsigned mask) noexcept
+{
+#ifdef _MSC_VER
+    unsigned long i;
+    _BitScanForward(&i, mask);
+    return static_cast<unsigned>(i);
+#else
+    return static_cast<unsigned>(
+        __builtin_ctz(mask));
+#endif
+}
+
+// Returns a mask with 0xff in every lane
+// holding an unreserved character:
+//
+// unreserved = ALPHA / DIGIT / "-" / "." / "_" / "~"
+//
+// Every percent-encoding set in char_type.hpp
+// is a superset of unreserved, and none of them
+// contain '%', so a run of these characters is
+// valid in any component without further checks.
+//
+// The range tests use signed compares, bytes
+// 0x80 and above are negative and never match.
+BOOST_URL_FORCEINLINE
+__m128i
+unreserved_mask(__m128i v) noexcept
+{
+    auto const lo = _mm_or_si128(
+        v, _mm_set1_epi8(0x20));
+    auto const alpha = _mm_and_si128(
+        _mm_cmpgt_epi8(lo, _mm_set1_epi8('a' - 1)),
+        _mm_cmplt_epi8(lo, _mm_set1_epi8('z' + 1)));
+    auto const digit = _mm_and_si128(
+        _mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+        _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+    auto const mark = _mm_or_si128(
+        _mm_or_si128(
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('-')),
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('.'))),
+        _mm_or_si128(
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('_')),
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('~'))));
+    return _mm_or_si128(
+        _mm_or_si128(alpha, digit), mark);
+}
+
+#ifdef BOOST_URL_USE_AVX2
+BOOST_URL_FORCEINLINE
+__m256i
+unreserved_mask(__m256i v) noexcept
+{
+    auto const lo = _mm256_or_si256(
+        v, _mm256_set1_epi8(0x20));
+    auto const alpha = _mm256_and_si256(
+        _mm256_cmpgt_epi8(lo, _mm256_set1_epi8('a' - 1)),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lo));
+    auto const digit = _mm256_and_si256(
+        _mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+    auto const mark = _mm256_or_si256(
+        _mm256_or_si256(
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('-')),
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('.'))),
+        _mm256_or_si256(
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')),
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('~'))));
+    return _mm256_or_si256(
+        _mm256_or_si256(alpha, digit), mark);
+}
+#endif
+
+// Returns the number of leading unreserved
+// characters in [p, end), examining only
+// whole blocks. The caller finishes the
+// tail and anything else with the scalar
+// table lookup.
+inline
+std::size_t
+count_unreserved(
+    char const* p,
+    char const* const end) noexcept
+{
+    auto const p0 = p;
+#ifdef BOOST_URL_USE_AVX2
+    while(end - p >= 32)
+    {
+        auto const m = static_cast<unsigned>(
+            _mm256_movemask_epi8(unreserved_mask(
+                _mm256_loadu_si256(reinterpret_cast<
+                    __m256i const*>(p)))));
+        if(m != 0xffffffff)
+            return (p - p0) + ctz(~m);
+        p += 32;
+    }
+#endif
+    while(end - p >= 16)
+    {
+        auto const m = static_cast<unsigned>(
+            _mm_movemask_epi8(unreserved_mask(
+                _mm_loadu_si128(reinterpret_cast<
+                    __m128i const*>(p)))));
+        if(m != 0xffff)
+            return (p - p0) + ctz(~m);
+        p += 16;
+    }
+    return p - p0;
+}
+
+// Returns the number of bits set
+inline
+unsigned
+popcount(unsigned mask) noexcept
+{
+#ifdef _MSC_VER
+    return __popcnt(mask);
+#else
+    return static_cast<unsigned>(
+        __builtin_popcount(mask));
+#endif
+}
+
+#else
+
+inline
+std::size_t
+count_unreserved(
+    char const*,
+    char const*) noexcept
+{
+    return 0;
+}
+
+#endif
+
+//----------------------------------------------------------
+//
+// Encoding
+//
+// Each percent-encoding set has a 16 byte
+// nibble table in char_tables, where bit h
+// of entry n is set when the character
+// 16 * h + n is in the set. A byte is then
+// classified with two shuffles: one looks
+// up its low nibble in the table, the other
+// turns its high nibble into a row bit,
+// and the byte is in the set when the two
+// have a bit in common. High nibbles 8 and
+// above have no row bit, so bytes 0x80 and
+// above are never in a set.
+//
+//----------------------------------------------------------
+
+#ifdef BOOST_URL_USE_SSSE3
+
+// Returns a mask with a bit set for
+// every byte of `v` not in the set
+BOOST_URL_FORCEINLINE
+unsigned
+special_mask(
+    __m128i v,
+    __m128i nib) noexcept
+{
+    auto const rows = _mm_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128,
+        0, 0, 0, 0, 0, 0, 0, 0);
+    auto const lo = _mm_and_si128(
+        v, _mm_set1_epi8(0x0f));
+    auto const hi = _mm_and_si128(
+        _mm_srli_epi16(v, 4),
+        _mm_set1_epi8(0x0f));
+    auto const m = _mm_and_si128(
+        _mm_shuffle_epi8(nib, lo),
+        _mm_shuffle_epi8(rows, hi));
+    return static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(
+            m, _mm_setzero_si128())));
+}
+
+#ifdef BOOST_URL_USE_AVX2
+BOOST_URL_FORCEINLINE
+unsigned
+special_mask(
+    __m256i v,
+    __m256i nib) noexcept
+{
+    // shuffles work within each 128-bit
+    // lane, so the tables are repeated
+    auto const rows = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128,
+        0, 0, 0, 0, 0, 0, 0, 0,
+        1, 2, 4, 8, 16, 32, 64, -128,
+        0, 0, 0, 0, 0, 0, 0, 0);
+    auto const lo = _mm256_and_si256(
+        v, _mm256_set1_epi8(0x0f));
+    auto const hi = _mm256_and_si256(
+        _mm256_srli_epi16(v, 4),
+        _mm256_set1_epi8(0x0f));
+    auto const m = _mm256_and_si256(
+        _mm256_shuffle_epi8(nib, lo),
+        _mm256_shuffle_epi8(rows, hi));
+    return static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            m, _mm256_setzero_si256())));
+}
+#endif
+
+// Write the bytes of a block with
+// specials marked in `m`, returning
+// one past the last byte written
+BOOST_URL_FORCEINLINE
+char*
+encode_block(
+    char* dest,
+    char const* p,
+    unsigned n,
+    unsigned m) noexcept
+{
+    static constexpr char hex[] =
+        "0123456789ABCDEF";
+    // the bytes before the
+    // first special are in place
+    for(auto i = ctz(m);
+        i < n; ++i)
+    {
+        auto const u = static_cast<
+            unsigned char>(p[i]);
+        if(! ((m >> i) & 1))
+        {
+            *dest++ = p[i];
+            continue;
+        }
+        dest[0] = '%';
+        dest[1] = hex[u >> 4];
+        dest[2] = hex[u & 0xf];
+        dest += 3;
+    }
+    return dest;
+}
+
+// Returns the number of bytes not in
+// the set, examining only whole blocks
+// from `p`, which is advanced past them.
+inline
+std::size_t
+count_special(
+    char const*& p,
+    char const* const end,
+    char const* nib) noexcept
+{
+    std::size_t n = 0;
+    auto const t = _mm_loadu_si128(
+        reinterpret_cast<
+            __m128i const*>(nib));
+#ifdef BOOST_URL_USE_AVX2
+    auto const t2 =
+        _mm256_broadcastsi128_si256(t);
+    while(end - p >= 32)
+    {
+        n += popcount(special_mask(
+            _mm256_loadu_si256(reinterpret_cast<
+                __m256i const*>(p)), t2));
+        p += 32;
+    }
+#endif
+    while(end - p >= 16)
+    {
+        n += popcount(special_mask(
+            _mm_loadu_si128(reinterpret_cast<
+                __m128i const*>(p)), t));
+        p += 16;
+    }
+    return n;
+}
+
+// Percent-encode the bytes not in the
+// set, examining only whole blocks from
+// `p`, which is advanced past them.
+// Returns one past the last byte written.
+//
+// Each block is stored as-is, so the
+// bytes before the first special are
+// written by the store. The output is
+// never shorter than the input, so a
+// buffer sized for the encoded string
+// always has room for the store.
+inline
+char*
+encode_blocks(
+    char* dest,
+    char const*& p,
+    char const* const end,
+    char const* nib) noexcept
+{
+    auto const t = _mm_loadu_si128(
+        reinterpret_cast<
+            __m128i const*>(nib));
+#ifdef BOOST_URL_USE_AVX2
+    auto const t2 =
+        _mm256_broadcastsi128_si256(t);
+    while(end - p >= 32)
+    {
+        auto const v = _mm256_loadu_si256(
+            reinterpret_cast<
+                __m256i const*>(p));
+        _mm256_storeu_si256(reinterpret_cast<
+            __m256i*>(dest), v);
+        auto const m = special_mask(v, t2);
+        if(m == 0)
+            dest += 32;
+        else
+            dest = encode_block(
+                dest + ctz(m), p, 32, m);
+        p += 32;
+    }
+#endif
+    while(end - p >= 16)
+    {
+        auto const v = _mm_loadu_si128(
+            reinterpret_cast<
+                __m128i const*>(p));
+        _mm_storeu_si128(reinterpret_cast<
+            __m128i*>(dest), v);
+        auto const m = special_mask(v, t);
+        if(m == 0)
+            dest += 16;
+        else
+            dest = encode_block(
+                dest + ctz(m), p, 16, m);
+        p += 16;
+    }
+    return dest;
+}
+
+#else
+
+inline
+std::size_t
+count_special(
+    char const*&,
+    char const*,
+    char const*) noexcept
+{
+    return 0;
+}
+
+inline
+char*
+encode_blocks(
+    char* dest,
+    char const*&,
+    char const*,
+    char const*) noexcept
+{
+    return dest;
+}
+
+#endif
+
+//----------------------------------------------------------
+
+// Returns the value of a HEXDIG
+// without a table lookup or a branch.
+// Precondition: c is a valid HEXDIG
+BOOST_URL_FORCEINLINE
+unsigned
+hex_value(char c) noexcept
+{
+    // '0'...'9' are 0x30...0x39, and
+    // both 'A'...'F' and 'a'...'f' have
+    // bit 6 set and the low nibble 1...6
+    auto const u = static_cast<
+        unsigned char>(c);
+    return (u & 0xf) + 9 * (u >> 6);
+}
+
+// Returns the number of '%' in [p, end)
+inline
+std::size_t
+count_pct(
+    char const* p,
+    char const* const end) noexcept
+{
+    std::size_t n = 0;
+#ifdef BOOST_URL_USE_SSE2
+    auto const pct =
+        _mm_set1_epi8('%');
+    while(end - p >= 16)
+    {
+        n += popcount(static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(
+                _mm_loadu_si128(reinterpret_cast<
+                    __m128i const*>(p)), pct))));
+        p += 16;
+    }
+#endif
+    while(p < end)
+        n += *p++ == '%';
+    return n;
+}
+
+// Decode the run of escapes at p,
+// which points to a '%', returning
+// one past the end of the run.
+// Encoded UTF-8 is mostly runs.
+BOOST_URL_FORCEINLINE
+char const*
+decode_escapes(
+    char*& dest,
+    char const* p,
+    char const* const end) noexcept
+{
+    do
+    {
+        *dest++ = static_cast<char>(
+            (hex_value(p[1]) << 4) |
+                hex_value(p[2]));
+        p += 3;
+    }
+    while(
+        p < end &&
+        *p == '%');
+    return p;
+}
+
+// Decode the percent-encoded string
+// [p, end) into [dest, dest_end),
+// returning one past the last byte
+// written.
+//
+// Whole blocks are copied to the output
+// and then the first run of escapes in the
+// block, if any, is decoded over its '%'. Blocks
+// are only stored while `dest_end` leaves
+// room for them, so an output buffer sized
+// for the decoded string exactly is safe,
+// while one the size of the input takes
+// the vector path until the end.
+//
+// Precondition: [p, end) is a valid
+// percent-encoded string, and the output
+// has room for the decoded bytes.
+inline
+char*
+decode_unchecked(
+    char* dest,
+    char const* const dest_end,
+    char const* p,
+    char const* const end) noexcept
+{
+#ifdef BOOST_URL_USE_SSE2
+#ifdef BOOST_URL_USE_AVX2
+    auto const pct32 =
+        _mm256_set1_epi8('%');
+    while(
+        end - p >= 32 &&
+        dest_end - dest >= 32)
+    {
+        auto const v = _mm256_loadu_si256(
+            reinterpret_cast<
+                __m256i const*>(p));
+        _mm256_storeu_si256(reinterpret_cast<
+            __m256i*>(dest), v);
+        auto const m = static_cast<unsigned>(
+            _mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(v, pct32)));
+        if(m == 0)
+        {
+            p += 32;
+            dest += 32;
+            continue;
+        }
+        auto const k = ctz(m);
+        p += k;
+        dest += k;
+        p = decode_escapes(dest, p, end);
+    }
+#endif
+    auto const pct =
+        _mm_set1_epi8('%');
+    while(
+        end - p >= 16 &&
+        dest_end - dest >= 16)
+    {
+        auto const v = _mm_loadu_si128(
+            reinterpret_cast<
+                __m128i const*>(p));
+        _mm_storeu_si128(reinterpret_cast<
+            __m128i*>(dest), v);
+        auto const m = static_cast<unsigned>(
+            _mm_movemask_epi8(
+                _mm_cmpeq_epi8(v, pct)));
+        if(m == 0)
+        {
+            p += 16;
+            dest += 16;
+            continue;
+        }
+        auto const k = ctz(m);
+        p += k;
+        dest += k;
+        p = decode_escapes(dest, p, end);
+    }
+#else
+    (void)dest_end;
+#endif
+    while(p < end)
+    {
+        if(*p != '%')
+        {
+            *dest++ = *p++;
+            continue;
+        }
+        p = decode_escapes(dest, p, end);
+    }
+    return dest;
+}
+
+} // detail
+} // urls
+} // boost
+
+#endif
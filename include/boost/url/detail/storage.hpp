@@ -11,6 +11,7 @@
 #define BOOST_URL_DETAIL_STORAGE_HPP
 
 #include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
@@ -26,16 +27,93 @@ struct storage
 
     virtual std::size_t size() const noexcept = 0;
     BOOST_URL_NODISCARD virtual char* resize(std::size_t n) = 0;
+
+    // Like resize, but the contents are
+    // discarded, and no more than n chars
+    // are reserved
+    BOOST_URL_NODISCARD virtual char* resize_exact(std::size_t n) = 0;
+};
+
+// Characters stored in the object
+// itself, used until they run out
+template<std::size_t N>
+class inline_buffer
+{
+    char buf_[N + 1];
+
+protected:
+    char*
+    inline_data() noexcept
+    {
+        return buf_;
+    }
+
+    // copies n chars at s
+    // to the inline buffer
+    void
+    inline_copy(
+        char const* s,
+        std::size_t n) noexcept
+    {
+        std::memcpy(buf_, s, n);
+    }
+};
+
+template<>
+class inline_buffer<0>
+{
+protected:
+    char*
+    inline_data() noexcept
+    {
+        return nullptr;
+    }
+
+    void
+    inline_copy(
+        char const*,
+        std::size_t) noexcept
+    {
+    }
 };
 
+// Grows the allocation of n chars at p
+// to new_n chars without moving it, if
+// the allocator knows how to.
+template<class Allocator>
+auto
+try_extend(
+    Allocator& a,
+    char* p,
+    std::size_t n,
+    std::size_t new_n,
+    int) noexcept ->
+        decltype(a.try_extend(p, n, new_n))
+{
+    return a.try_extend(p, n, new_n);
+}
+
 template<class Allocator>
+bool
+try_extend(
+    Allocator&,
+    char*,
+    std::size_t,
+    std::size_t,
+    long) noexcept
+{
+    return false;
+}
+
+template<class Allocator, std::size_t N = 0>
 class alloc_storage
     : public storage
+    , private inline_buffer<N>
 {
     Allocator a_;
-    char* p_ = nullptr;
+    char* p_;
     std::size_t size_ = 0;
-    std::size_t cap_ = 0;
+    std::size_t cap_ = N;
 
     using traits =
         std::allocator_traits<
@@ -46,12 +124,15 @@ public:
     alloc_storage(
         Allocator const& a)
         : a_(a)
+        , p_(this->inline_data())
     {
+        if(p_)
+            p_[0] = 0;
     }
 
     ~alloc_storage()
     {
-        if(p_)
+        if(p_ != this->inline_data())
             traits::deallocate(a_,
                 p_, cap_ + 1);
     }
@@ -69,6 +150,16 @@ public:
         if(n <= cap_)
             return p_;
 
+        // nothing is copied, so the
+        // block grows only as needed
+        if( p_ != this->inline_data() &&
+            try_extend(a_, p_,
+                cap_ + 1, n + 1, 0))
+        {
+            cap_ = n;
+            return p_;
+        }
+
         std::size_t cap =
             traits::max_size(a_);
         if(cap_ < cap - cap_)
@@ -82,8 +173,9 @@ public:
         {
             std::memcpy(
                 p, p_, size_ + 1);
-            a_.deallocate(
-                p_, cap_ + 1);
+            if(p_ != this->inline_data())
+                a_.deallocate(
+                    p_, cap_ + 1);
             p[size_] = 0;
         }
         p_ = p;
@@ -110,12 +202,113 @@ public:
         else
             return p;
     }
+
+    Allocator const&
+    get_allocator() const noexcept
+    {
+        return a_;
+    }
+
+    // Frees the allocated buffer, going
+    // back to the inline one if any
+    void
+    release() noexcept
+    {
+        if(p_ != this->inline_data())
+            traits::deallocate(a_,
+                p_, cap_ + 1);
+        p_ = this->inline_data();
+        cap_ = N;
+        size_ = 0;
+        if(p_)
+            p_[0] = 0;
+    }
+
+    // Replaces the allocator. The
+    // buffer must have been released.
+    void
+    set_allocator(
+        Allocator const& a) noexcept
+    {
+        BOOST_ASSERT(
+            p_ == this->inline_data());
+        a_ = a;
+    }
+
+    // Like resize, but the contents are
+    // discarded, and one allocation of
+    // exactly n chars is made if they
+    // do not fit
+    BOOST_URL_NODISCARD
+    char*
+    resize_exact(std::size_t n) override
+    {
+        if( n > cap_ &&
+            p_ != this->inline_data() &&
+            try_extend(a_, p_,
+                cap_ + 1, n + 1, 0))
+            cap_ = n;
+        if(n > cap_)
+        {
+            auto const p =
+                traits::allocate(a_, n + 1);
+            release();
+            p_ = p;
+            cap_ = n;
+        }
+        if(! p_)
+            return nullptr;
+        size_ = n;
+        p_[n] = 0;
+        return p_;
+    }
+
+    // Replaces the contents with
+    // a copy of n chars at s
+    char*
+    assign(
+        char const* s,
+        std::size_t n)
+    {
+        auto const p = resize_exact(n);
+        if(n > 0)
+            std::memcpy(p, s, n);
+        return p;
+    }
+
+    // Takes the contents of other, which
+    // uses an equal allocator. Inline
+    // chars are copied, since they can
+    // not change owner.
+    char*
+    steal(alloc_storage& other) noexcept
+    {
+        release();
+        if(other.p_ == other.inline_data())
+        {
+            this->inline_copy(other.p_,
+                other.size_ + 1);
+            size_ = other.size_;
+        }
+        else
+        {
+            p_ = other.p_;
+            cap_ = other.cap_;
+            size_ = other.size_;
+            other.p_ = other.inline_data();
+            other.cap_ = N;
+        }
+        other.size_ = 0;
+        if(other.p_)
+            other.p_[0] = 0;
+        return p_;
+    }
 };
 
-template<class Allocator>
+template<class Allocator, std::size_t N>
 struct storage_member
 {
-    alloc_storage<Allocator> st_;
+    alloc_storage<Allocator, N> st_;
 
     explicit
     storage_member(
@@ -125,6 +318,78 @@ struct storage_member
     }
 };
 
+//----------------------------------------------------------
+
+// Storage in a caller-provided buffer of
+// fixed size, which never allocates
+class fixed_storage
+    : public storage
+{
+    char* p_;
+    std::size_t size_ = 0;
+    std::size_t cap_;
+
+public:
+    // p points to cap + 1 chars
+    fixed_storage(
+        char* p,
+        std::size_t cap) noexcept
+        : p_(p)
+        , cap_(cap)
+    {
+        p_[0] = 0;
+    }
+
+    std::size_t
+    capacity() const noexcept override
+    {
+        return cap_;
+    }
+
+    BOOST_URL_NODISCARD
+    char*
+    reserve(std::size_t n) override
+    {
+        if(n > cap_)
+            too_large::raise();
+        return p_;
+    }
+
+    std::size_t
+    size() const noexcept override
+    {
+        return size_;
+    }
+
+    BOOST_URL_NODISCARD
+    char*
+    resize(std::size_t n) override
+    {
+        auto const p = reserve(n);
+        size_ = n;
+        p[n] = 0;
+        return p;
+    }
+    BOOST_URL_NODISCARD
+    char*
+    resize_exact(std::size_t n) override
+    {
+        return resize(n);
+    }
+};
+
+template<std::size_t N>
+struct fixed_storage_member
+{
+    char buf_[N + 1];
+    fixed_storage st_;
+
+    fixed_storage_member() noexcept
+        : st_(buf_, N)
+    {
+    }
+};
+
 } // detail
 } // urls
 } // boost
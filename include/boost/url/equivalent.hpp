@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_EQUIVALENT_HPP
+#define BOOST_URL_EQUIVALENT_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/url_view.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+/** Return true if two URLs are equivalent.
+
+    Two URLs are equivalent when their normalized
+    forms are equal, where the normal form is
+    obtained by applying the syntax-based
+    normalizations of rfc3986 section 6.2.2 and
+    the elision of a default port:
+
+    @li The scheme and host are compared without
+    regard to case.
+
+    @li An escape of an unreserved character is
+    equal to the character itself, and the hex
+    digits of other escapes are compared without
+    regard to case.
+
+    @li Dot segments are removed from an absolute
+    path as described in rfc3986 section 5.2.4.
+
+    @li An empty port, or a port equal to the
+    default for the scheme, is the same as no
+    port. IP addresses are compared by value.
+
+    The URLs are compared in place, in a single
+    pass, and no memory is allocated.
+
+    @par Example
+    @code
+    assert( equivalent(
+        url_view( "HTTP://www.Example.com:80/a/./b/../c/%7Euser" ),
+        url_view( "http://www.example.com/a/c/~user" ) ) );
+    @endcode
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @see hash_normalized
+*/
+BOOST_URL_DECL
+bool
+equivalent(
+    url_view const& u0,
+    url_view const& u1) noexcept;
+
+/** Return a hash of the normalized form of a URL.
+
+    This function returns the 32 or 64 bit FNV-1a
+    hash, according to the size of `std::size_t`,
+    of the normalized form of the URL described
+    in @ref equivalent, where the segments of the
+    path are visited from last to first. URLs
+    which are equivalent have equal hashes. The
+    normalized form is produced on the fly, in a
+    single pass, and no memory is allocated.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @see equivalent
+*/
+BOOST_URL_DECL
+std::size_t
+hash_normalized(
+    url_view const& u) noexcept;
+
+/** A hash function object for URLs, using their normalized form.
+
+    This can be used with @ref normalized_equal
+    to key unordered containers by URL, so that
+    equivalent URLs refer to the same element.
+
+    @par Example
+    @code
+    std::unordered_map<
+        url_view, int,
+        normalized_hash,
+        normalized_equal> m;
+    @endcode
+*/
+struct normalized_hash
+{
+    std::size_t
+    operator()(
+        url_view const& u) const noexcept
+    {
+        return hash_normalized(u);
+    }
+};
+
+/** An equality function object for URLs, using their normalized form.
+
+    @see normalized_hash
+*/
+struct normalized_equal
+{
+    bool
+    operator()(
+        url_view const& u0,
+        url_view const& u1) const noexcept
+    {
+        return equivalent(u0, u1);
+    }
+};
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/equivalent.ipp>
+#endif
+
+#endif
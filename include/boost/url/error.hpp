@@ -121,7 +121,17 @@ enum class error
     incomplete_pct_encoding,
 
     /// Illegal reserved character in encoded string.
-    illegal_reserved_char
+    illegal_reserved_char,
+
+    //---
+
+    /** More input is needed.
+
+        This error is returned by an incremental
+        parser when the input received so far
+        does not complete the element.
+    */
+    need_more
 };
 
 enum class condition
@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_DECODE_HPP
+#define BOOST_URL_IMPL_DECODE_HPP
+
+#include <boost/url/detail/char_type.hpp>
+#include <type_traits>
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+
+template<class OutputIt>
+OutputIt
+decode_to(
+    string_view s,
+    OutputIt out,
+    std::false_type)
+{
+    auto p = s.data();
+    auto const end = p + s.size();
+    while(p < end)
+    {
+        if(*p != '%')
+        {
+            *out++ = *p++;
+            continue;
+        }
+        *out++ = static_cast<char>(
+            (hex_value(p[1]) << 4) |
+                hex_value(p[2]));
+        p += 3;
+    }
+    return out;
+}
+
+// pointers take the vector path
+inline
+char*
+decode_to(
+    string_view s,
+    char* dest,
+    std::true_type)
+{
+    return pct_encoding::decode(
+        dest, s);
+}
+
+} // detail
+
+template<class OutputIt>
+OutputIt
+decode_to(
+    string_view s,
+    OutputIt out)
+{
+    error_code ec;
+    decoded_size(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return detail::decode_to(s, out,
+        std::is_same<OutputIt, char*>{});
+}
+
+template<class Allocator>
+void
+append_decoded(
+    string_view s,
+    std::basic_string<char,
+        std::char_traits<char>,
+            Allocator>& dest)
+{
+    error_code ec;
+    auto const n = decoded_size(s, ec);
+    if(ec)
+        invalid_part::raise();
+    auto const n0 = dest.size();
+    dest.resize(n0 + n);
+    if(s.empty())
+        return;
+    detail::pct_encoding::decode(
+        &dest[n0], s);
+}
+
+} // urls
+} // boost
+
+#endif
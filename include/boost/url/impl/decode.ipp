@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_DECODE_IPP
+#define BOOST_URL_IMPL_DECODE_IPP
+
+#include <boost/url/decode.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/detail/char_type.hpp>
+
+namespace boost {
+namespace urls {
+
+std::size_t
+decoded_size(
+    string_view s) noexcept
+{
+#ifndef NDEBUG
+    error_code ec;
+    detail::pct_encoding::
+        checked_decoded_size(s, ec);
+    BOOST_ASSERT(! ec);
+#endif
+    return detail::pct_encoding::
+        raw_decoded_size(s);
+}
+
+std::size_t
+decoded_size(
+    string_view s,
+    error_code& ec) noexcept
+{
+    return detail::pct_encoding::
+        checked_decoded_size(s, ec);
+}
+
+string_view
+decode_to(
+    string_view s,
+    char* dest,
+    std::size_t cap)
+{
+    error_code ec;
+    auto const n = decoded_size(s, ec);
+    if(ec)
+        invalid_part::raise();
+    if(n > cap)
+        too_large::raise();
+    detail::decode_unchecked(
+        dest, dest + n, s.data(),
+        s.data() + s.size());
+    return string_view(dest, n);
+}
+
+} // urls
+} // boost
+
+#endif
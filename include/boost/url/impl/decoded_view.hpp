@@ -0,0 +1,38 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_DECODED_VIEW_HPP
+#define BOOST_URL_IMPL_DECODED_VIEW_HPP
+
+namespace boost {
+namespace urls {
+
+inline
+auto
+decoded_view::
+begin() const noexcept ->
+    iterator
+{
+    return iterator(s_.data());
+}
+
+inline
+auto
+decoded_view::
+end() const noexcept ->
+    iterator
+{
+    return iterator(
+        s_.data() + s_.size());
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,268 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_DECODED_VIEW_IPP
+#define BOOST_URL_IMPL_DECODED_VIEW_IPP
+
+#include <boost/url/decoded_view.hpp>
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+
+// Walks a string in either direction,
+// decoding escapes when `pct` is set
+struct decoded_cursor
+{
+    char const* begin;
+    char const* p;
+    char const* end;
+    bool pct;
+
+    decoded_cursor(
+        string_view s,
+        bool pct_,
+        bool at_end) noexcept
+        : begin(s.data())
+        , p(at_end ?
+            s.data() + s.size() :
+            s.data())
+        , end(s.data() + s.size())
+        , pct(pct_)
+    {
+    }
+
+    static
+    unsigned char
+    unescape(char const* p) noexcept
+    {
+        return static_cast<unsigned char>(
+            (static_cast<unsigned char>(
+                hex_digit(p[1])) << 4) +
+            static_cast<unsigned char>(
+                hex_digit(p[2])));
+    }
+
+    bool
+    at_begin() const noexcept
+    {
+        return p == begin;
+    }
+
+    bool
+    at_end() const noexcept
+    {
+        return p == end;
+    }
+
+    unsigned char
+    next() noexcept
+    {
+        if( pct && *p == '%')
+        {
+            auto const c = unescape(p);
+            p += 3;
+            return c;
+        }
+        return static_cast<
+            unsigned char>(*p++);
+    }
+
+    // In a valid encoding every '%'
+    // begins an escape, so the previous
+    // character is an escape exactly when
+    // the third one back is a '%'.
+    unsigned char
+    prev() noexcept
+    {
+        if( pct &&
+            p - begin >= 3 &&
+            p[-3] == '%')
+        {
+            p -= 3;
+            return unescape(p);
+        }
+        return static_cast<
+            unsigned char>(*--p);
+    }
+};
+
+inline
+unsigned char
+fold_icase(
+    unsigned char c) noexcept
+{
+    return static_cast<unsigned char>(
+        to_lower(static_cast<char>(c)));
+}
+
+template<bool ICase>
+unsigned char
+fold(unsigned char c) noexcept
+{
+    return ICase ? fold_icase(c) : c;
+}
+
+template<bool ICase>
+int
+compare(
+    decoded_cursor a,
+    decoded_cursor b) noexcept
+{
+    while(
+        ! a.at_end() &&
+        ! b.at_end())
+    {
+        auto const c0 =
+            fold<ICase>(a.next());
+        auto const c1 =
+            fold<ICase>(b.next());
+        if(c0 != c1)
+            return c0 < c1 ? -1 : 1;
+    }
+    if(! a.at_end())
+        return 1;
+    if(! b.at_end())
+        return -1;
+    return 0;
+}
+
+// true if b is a prefix of a
+template<bool ICase>
+bool
+starts_with(
+    decoded_cursor a,
+    decoded_cursor b) noexcept
+{
+    while(! b.at_end())
+    {
+        if(a.at_end())
+            return false;
+        if( fold<ICase>(a.next()) !=
+            fold<ICase>(b.next()))
+            return false;
+    }
+    return true;
+}
+
+// true if b is a suffix of a
+template<bool ICase>
+bool
+ends_with(
+    decoded_cursor a,
+    decoded_cursor b) noexcept
+{
+    while(! b.at_begin())
+    {
+        if(a.at_begin())
+            return false;
+        if( fold<ICase>(a.prev()) !=
+            fold<ICase>(b.prev()))
+            return false;
+    }
+    return true;
+}
+
+} // detail
+
+int
+decoded_view::
+compare(
+    string_view s) const noexcept
+{
+    return detail::compare<false>(
+        { s_, true, false },
+        { s, false, false });
+}
+
+int
+decoded_view::
+compare(
+    decoded_view other) const noexcept
+{
+    return detail::compare<false>(
+        { s_, true, false },
+        { other.s_, true, false });
+}
+
+int
+decoded_view::
+compare_icase(
+    string_view s) const noexcept
+{
+    return detail::compare<true>(
+        { s_, true, false },
+        { s, false, false });
+}
+
+bool
+decoded_view::
+starts_with(
+    string_view s) const noexcept
+{
+    return detail::starts_with<false>(
+        { s_, true, false },
+        { s, false, false });
+}
+
+bool
+decoded_view::
+starts_with_icase(
+    string_view s) const noexcept
+{
+    return detail::starts_with<true>(
+        { s_, true, false },
+        { s, false, false });
+}
+
+bool
+decoded_view::
+ends_with(
+    string_view s) const noexcept
+{
+    return detail::ends_with<false>(
+        { s_, true, true },
+        { s, false, true });
+}
+
+bool
+decoded_view::
+ends_with_icase(
+    string_view s) const noexcept
+{
+    return detail::ends_with<true>(
+        { s_, true, true },
+        { s, false, true });
+}
+
+std::size_t
+decoded_view::
+hash() const noexcept
+{
+    return detail::encoded_key_hash(s_);
+}
+
+std::size_t
+decoded_view::
+hash_icase() const noexcept
+{
+    detail::key_hasher h;
+    detail::decoded_cursor c(
+        s_, true, false);
+    while(! c.at_end())
+        h(static_cast<char>(
+            detail::fold_icase(c.next())));
+    return h.h;
+}
+
+} // urls
+} // boost
+
+#endif
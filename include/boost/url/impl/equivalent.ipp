@@ -0,0 +1,477 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_EQUIVALENT_IPP
+#define BOOST_URL_IMPL_EQUIVALENT_IPP
+
+#include <boost/url/equivalent.hpp>
+#include <boost/url/ipv4_address.hpp>
+#include <boost/url/ipv6_address.hpp>
+#include <boost/url/scheme.hpp>
+#include <boost/url/detail/char_type.hpp>
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+
+// A character of a normalized
+// component, escaped or not
+struct norm_char
+{
+    unsigned char c;
+    bool esc;
+};
+
+// Yields the characters of an encoded string
+// normalized as in rfc3986 section 6.2.2.
+// Escaped unreserved characters are decoded,
+// and when icase is set, letters which are
+// not escaped are folded to lower case.
+class norm_cursor
+{
+    char const* p_;
+    char const* end_;
+    bool icase_;
+
+public:
+    norm_cursor(
+        string_view s,
+        bool icase) noexcept
+        : p_(s.data())
+        , end_(s.data() + s.size())
+        , icase_(icase)
+    {
+    }
+
+    bool
+    done() const noexcept
+    {
+        return p_ == end_;
+    }
+
+    norm_char
+    next() noexcept
+    {
+        auto c = *p_;
+        bool esc = false;
+        if(c == '%')
+        {
+            c = static_cast<char>(
+                (static_cast<unsigned char>(
+                    hex_digit(p_[1])) << 4) +
+                static_cast<unsigned char>(
+                    hex_digit(p_[2])));
+            esc = ! is_unreserved(c);
+            p_ += 3;
+        }
+        else
+        {
+            ++p_;
+        }
+        if( icase_ && ! esc)
+            c = to_lower(c);
+        return { static_cast<
+            unsigned char>(c), esc };
+    }
+};
+
+inline
+bool
+norm_equal(
+    string_view s0,
+    string_view s1,
+    bool icase) noexcept
+{
+    norm_cursor c0(s0, icase);
+    norm_cursor c1(s1, icase);
+    while(
+        ! c0.done() &&
+        ! c1.done())
+    {
+        auto const e0 = c0.next();
+        auto const e1 = c1.next();
+        if( e0.c != e1.c ||
+            e0.esc != e1.esc)
+            return false;
+    }
+    return c0.done() && c1.done();
+}
+
+// Returns 1 for ".", 2 for "..",
+// counting escaped dots, else 0
+inline
+int
+dot_segment(
+    string_view s) noexcept
+{
+    int n = 0;
+    norm_cursor c(s, false);
+    while(! c.done())
+    {
+        auto const e = c.next();
+        if( e.esc ||
+            e.c != '.' ||
+            ++n > 2)
+            return 0;
+    }
+    return n;
+}
+
+// Yields the segments of a path with the
+// dot segments removed as in rfc3986
+// section 5.2.4, from last to first,
+// without allocating. Walking backwards,
+// a ".." only needs to count the segments
+// it removes, so the path is visited once.
+// In a relative path they are kept, as they
+// are significant when the path is resolved.
+class norm_path
+{
+    char const* begin_;
+    char const* end_;
+    std::size_t skip_ = 0;
+    bool done_;
+    bool abs_;
+    bool last_ = true;
+
+    // the raw segment before end_, moving
+    // end_ to the previous one or setting done
+    string_view
+    take() noexcept
+    {
+        auto p = end_;
+        while(
+            p > begin_ &&
+            p[-1] != '/')
+            --p;
+        string_view const s(p, end_ - p);
+        if(p == begin_)
+            done_ = true;
+        else
+            end_ = p - 1;
+        return s;
+    }
+
+public:
+    explicit
+    norm_path(
+        string_view s) noexcept
+        : begin_(s.data())
+        , end_(s.data() + s.size())
+        , done_(s.empty())
+        , abs_(! s.empty() &&
+            s.front() == '/')
+    {
+        if(abs_)
+            ++begin_;
+    }
+
+    bool
+    is_absolute() const noexcept
+    {
+        return abs_;
+    }
+
+    // Sets s to the previous segment,
+    // returning false if there are
+    // no more segments
+    bool
+    prev(string_view& s) noexcept
+    {
+        while(! done_)
+        {
+            s = take();
+            if(! abs_)
+                return true;
+            auto const d = dot_segment(s);
+            auto const last = last_;
+            last_ = false;
+            if(d == 0)
+            {
+                if(skip_ == 0)
+                    return true;
+                --skip_;
+                continue;
+            }
+            if(d == 2)
+                ++skip_;
+            // a trailing "." or ".."
+            // leaves an empty segment
+            if(last)
+            {
+                s = {};
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// Returns the port to compare, or -1 when
+// the port is absent, empty, or the
+// default for the scheme
+inline
+long
+norm_port(
+    url_view const& u) noexcept
+{
+    if(u.port().empty())
+        return -1;
+    auto const n = u.port_number();
+    auto const d = default_port(
+        u.scheme_id());
+    if( d != 0 &&
+        n == d)
+        return -1;
+    return n;
+}
+
+// Feeds the normalized
+// form to a hash function
+class norm_hasher
+{
+    key_hasher h_;
+
+public:
+    std::size_t
+    value() const noexcept
+    {
+        return h_.h;
+    }
+
+    void
+    put(char c) noexcept
+    {
+        h_(c);
+    }
+
+    void
+    put(string_view s) noexcept
+    {
+        for(auto c : s)
+            h_(c);
+    }
+
+    void
+    put_norm(
+        string_view s,
+        bool icase) noexcept
+    {
+        static constexpr char hex[] =
+            "0123456789ABCDEF";
+        norm_cursor c(s, icase);
+        while(! c.done())
+        {
+            auto const e = c.next();
+            if(! e.esc)
+            {
+                h_(static_cast<char>(e.c));
+                continue;
+            }
+            h_('%');
+            h_(hex[e.c >> 4]);
+            h_(hex[e.c & 0xf]);
+        }
+    }
+};
+
+inline
+bool
+host_equal(
+    url_view const& u0,
+    url_view const& u1) noexcept
+{
+    if(u0.host_type() != u1.host_type())
+        return false;
+    switch(u0.host_type())
+    {
+    case host_type::ipv4:
+        return u0.ipv4_address() ==
+            u1.ipv4_address();
+    case host_type::ipv6:
+        return u0.ipv6_address() ==
+            u1.ipv6_address();
+    default:
+        break;
+    }
+    return norm_equal(
+        u0.encoded_host(),
+        u1.encoded_host(), true);
+}
+
+inline
+void
+hash_host(
+    norm_hasher& h,
+    url_view const& u) noexcept
+{
+    switch(u.host_type())
+    {
+    case host_type::ipv4:
+    {
+        char buf[ipv4_address::max_str_len];
+        h.put(u.ipv4_address().to_buffer(
+            buf, sizeof(buf)));
+        return;
+    }
+    case host_type::ipv6:
+    {
+        char buf[ipv6_address::max_str_len];
+        h.put('[');
+        h.put(u.ipv6_address().to_buffer(
+            buf, sizeof(buf)));
+        h.put(']');
+        return;
+    }
+    default:
+        break;
+    }
+    h.put_norm(u.encoded_host(), true);
+}
+
+} // detail
+
+bool
+equivalent(
+    url_view const& u0,
+    url_view const& u1) noexcept
+{
+    if(! detail::norm_equal(
+            u0.scheme(), u1.scheme(), true))
+        return false;
+
+    // authority
+    if(u0.has_authority() !=
+        u1.has_authority())
+        return false;
+    if(u0.has_authority())
+    {
+        if(u0.has_userinfo() !=
+            u1.has_userinfo())
+            return false;
+        if(! detail::norm_equal(
+                u0.encoded_userinfo(),
+                u1.encoded_userinfo(), false))
+            return false;
+        if(! detail::host_equal(u0, u1))
+            return false;
+        if( detail::norm_port(u0) !=
+            detail::norm_port(u1))
+            return false;
+    }
+
+    // path
+    detail::norm_path p0(u0.encoded_path());
+    detail::norm_path p1(u1.encoded_path());
+    if( p0.is_absolute() !=
+        p1.is_absolute())
+        return false;
+    for(;;)
+    {
+        string_view s0;
+        string_view s1;
+        auto const more = p0.prev(s0);
+        if(more != p1.prev(s1))
+            return false;
+        if(! more)
+            break;
+        if(! detail::norm_equal(
+                s0, s1, false))
+            return false;
+    }
+
+    // query
+    if( u0.query_part().empty() !=
+        u1.query_part().empty())
+        return false;
+    if(! detail::norm_equal(
+            u0.encoded_query(),
+            u1.encoded_query(), false))
+        return false;
+
+    // fragment
+    if( u0.fragment_part().empty() !=
+        u1.fragment_part().empty())
+        return false;
+    return detail::norm_equal(
+        u0.encoded_fragment(),
+        u1.encoded_fragment(), false);
+}
+
+std::size_t
+hash_normalized(
+    url_view const& u) noexcept
+{
+    detail::norm_hasher h;
+    if(! u.scheme().empty())
+    {
+        h.put_norm(u.scheme(), true);
+        h.put(':');
+    }
+
+    // authority
+    if(u.has_authority())
+    {
+        h.put("//");
+        if(u.has_userinfo())
+        {
+            h.put_norm(
+                u.encoded_userinfo(), false);
+            h.put('@');
+        }
+        detail::hash_host(h, u);
+        auto const port =
+            detail::norm_port(u);
+        if(port >= 0)
+        {
+            h.put(':');
+            h.put(detail::port_string(
+                static_cast<unsigned>(
+                    port)).get());
+        }
+    }
+
+    // path, from the last segment
+    // to the first
+    detail::norm_path p(u.encoded_path());
+    string_view s;
+    bool first = true;
+    while(p.prev(s))
+    {
+        if(! first)
+            h.put('/');
+        h.put_norm(s, false);
+        first = false;
+    }
+    if(p.is_absolute())
+        h.put('/');
+
+    // query
+    if(! u.query_part().empty())
+    {
+        h.put('?');
+        h.put_norm(
+            u.encoded_query(), false);
+    }
+
+    // fragment
+    if(! u.fragment_part().empty())
+    {
+        h.put('#');
+        h.put_norm(
+            u.encoded_fragment(), false);
+    }
+    return h.value();
+}
+
+} // urls
+} // boost
+
+#endif
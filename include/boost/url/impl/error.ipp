@@ -117,6 +117,8 @@ case error::missing_port: return "missing port";
 case error::bad_pct_encoding_digit: return "bad pct-encoding digit";
 case error::incomplete_pct_encoding: return "incomplete pct-encoding";
 case error::illegal_reserved_char: return "illegal reserved char";
+
+case error::need_more: return "need more";
             }
         }
 
@@ -0,0 +1,74 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_IPV4_ADDRESS_IPP
+#define BOOST_URL_IMPL_IPV4_ADDRESS_IPP
+
+#include <boost/url/ipv4_address.hpp>
+#include <boost/url/error.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+
+// Write `v` in decimal at `dest`,
+// returning one past the end
+inline
+char*
+print_octet(
+    char* dest,
+    unsigned char v) noexcept
+{
+    if(v >= 100)
+    {
+        *dest++ = '0' + v / 100;
+        v %= 100;
+        *dest++ = '0' + v / 10;
+        v %= 10;
+    }
+    else if(v >= 10)
+    {
+        *dest++ = '0' + v / 10;
+        v %= 10;
+    }
+    *dest++ = '0' + v;
+    return dest;
+}
+
+} // detail
+
+string_view
+ipv4_address::
+to_buffer(
+    char* dest,
+    std::size_t size) const
+{
+    char buf[max_str_len];
+    auto p = buf;
+    for(std::size_t i = 0; i < 4; ++i)
+    {
+        if(i > 0)
+            *p++ = '.';
+        p = detail::print_octet(
+            p, addr_[i]);
+    }
+    auto const n = static_cast<
+        std::size_t>(p - buf);
+    if(n > size)
+        too_large::raise();
+    std::memcpy(dest, buf, n);
+    return string_view(dest, n);
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_IPV6_ADDRESS_IPP
+#define BOOST_URL_IMPL_IPV6_ADDRESS_IPP
+
+#include <boost/url/ipv6_address.hpp>
+#include <boost/url/error.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+bool
+ipv6_address::
+is_v4_mapped() const noexcept
+{
+    for(std::size_t i = 0; i < 10; ++i)
+        if(addr_[i] != 0)
+            return false;
+    return
+        addr_[10] == 0xff &&
+        addr_[11] == 0xff;
+}
+
+string_view
+ipv6_address::
+to_buffer(
+    char* dest,
+    std::size_t size) const
+{
+    static constexpr char const* hex =
+        "0123456789abcdef";
+    char buf[max_str_len];
+    auto p = buf;
+    int const nw = is_v4_mapped() ? 6 : 8;
+    unsigned short w[8];
+    for(int i = 0; i < 8; ++i)
+        w[i] = static_cast<unsigned short>(
+            (addr_[2 * i] << 8) |
+                addr_[2 * i + 1]);
+
+    // find the longest run of at least
+    // two zero groups, the first one wins
+    int best = -1;
+    int best_n = 1;
+    for(int i = 0; i < nw;)
+    {
+        if(w[i] != 0)
+        {
+            ++i;
+            continue;
+        }
+        int j = i;
+        while(j < nw && w[j] == 0)
+            ++j;
+        if(j - i > best_n)
+        {
+            best = i;
+            best_n = j - i;
+        }
+        i = j;
+    }
+
+    // true when the next group
+    // needs a leading colon
+    bool sep = false;
+    for(int i = 0; i < nw;)
+    {
+        if(i == best)
+        {
+            *p++ = ':';
+            *p++ = ':';
+            i += best_n;
+            sep = false;
+            continue;
+        }
+        if(sep)
+            *p++ = ':';
+        sep = true;
+        auto const v = w[i++];
+        bool lead = true;
+        for(int s = 12; s > 0; s -= 4)
+        {
+            auto const d = (v >> s) & 0xf;
+            if(d == 0 && lead)
+                continue;
+            lead = false;
+            *p++ = hex[d];
+        }
+        *p++ = hex[v & 0xf];
+    }
+    if(nw == 6)
+    {
+        if(sep)
+            *p++ = ':';
+        ipv4_address::bytes_type b;
+        std::memcpy(&b[0], &addr_[12], 4);
+        p += ipv4_address(b).to_buffer(
+            p, buf + sizeof(buf) - p).size();
+    }
+    auto const n = static_cast<
+        std::size_t>(p - buf);
+    if(n > size)
+        too_large::raise();
+    std::memcpy(dest, buf, n);
+    return string_view(dest, n);
+}
+
+} // urls
+} // boost
+
+#endif
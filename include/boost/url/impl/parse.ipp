@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_PARSE_IPP
+#define BOOST_URL_IMPL_PARSE_IPP
+
+#include <boost/url/parse.hpp>
+#include <boost/url/detail/parse.hpp>
+
+namespace boost {
+namespace urls {
+
+result<url_view>
+parse_uri(string_view s) noexcept
+{
+    error_code ec;
+    detail::parts pt;
+    auto const n =
+        detail::parse_uri(pt, s, ec);
+    if(ec)
+        return { ec, n };
+    return { url_view(s.data(), pt), n };
+}
+
+result<url_view>
+parse_relative_ref(string_view s) noexcept
+{
+    error_code ec;
+    detail::parts pt;
+    auto const n =
+        detail::parse_relative_ref(pt, s, ec);
+    if(ec)
+        return { ec, n };
+    return { url_view(s.data(), pt), n };
+}
+
+result<url_view>
+parse_uri_reference(string_view s) noexcept
+{
+    error_code ec;
+    detail::parts pt;
+    auto const n =
+        detail::parse_url(pt, s, ec);
+    if(ec)
+        return { ec, n };
+    return { url_view(s.data(), pt), n };
+}
+
+//----------------------------------------------------------
+
+result<url_view>
+parse_origin_form(string_view s) noexcept
+{
+    detail::error_value ec;
+    detail::parts pt;
+    auto const n =
+        detail::parse_origin_form(pt, s, ec);
+    if(ec)
+        return { error_code(ec), n };
+    return { url_view(s.data(), pt), n };
+}
+
+result<url_view>
+parse_absolute_form(string_view s) noexcept
+{
+    detail::error_value ec;
+    detail::parts pt;
+    auto const n =
+        detail::parse_absolute_form(pt, s, ec);
+    if(ec)
+        return { error_code(ec), n };
+    return { url_view(s.data(), pt), n };
+}
+
+result<url_view>
+parse_authority_form(string_view s) noexcept
+{
+    detail::error_value ec;
+    detail::parts pt;
+    auto const n =
+        detail::parse_authority_form(pt, s, ec);
+    if(ec)
+        return { error_code(ec), n };
+    return { url_view(s.data(), pt), n };
+}
+
+result<url_view>
+parse_asterisk_form(string_view s) noexcept
+{
+    detail::error_value ec;
+    detail::parts pt;
+    auto const n =
+        detail::parse_asterisk_form(pt, s, ec);
+    if(ec)
+        return { error_code(ec), n };
+    return { url_view(s.data(), pt), n };
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_PARSE_URLS_IPP
+#define BOOST_URL_IMPL_PARSE_URLS_IPP
+
+#include <boost/url/parse_urls.hpp>
+#include <boost/url/detail/parse.hpp>
+
+namespace boost {
+namespace urls {
+
+std::size_t
+parse_urls(
+    string_view const* urls,
+    std::size_t n,
+    url_columns const& out) noexcept
+{
+    using namespace detail;
+
+    // Every row goes through the same
+    // parser and tables back to back,
+    // and each column is written
+    // sequentially.
+    std::size_t good = 0;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        parts pt;
+        error_code ec;
+        parse_url(pt, urls[i], ec);
+        if(ec)
+            pt = parts();
+        else
+            ++good;
+        if(out.user)
+            out.user[i] = pt.offset[id_user];
+        if(out.password)
+            out.password[i] = pt.offset[id_password];
+        if(out.host)
+            out.host[i] = pt.offset[id_host];
+        if(out.port)
+            out.port[i] = pt.offset[id_port];
+        if(out.path)
+            out.path[i] = pt.offset[id_path];
+        if(out.query)
+            out.query[i] = pt.offset[id_query];
+        if(out.fragment)
+            out.fragment[i] = pt.offset[id_frag];
+        if(out.end)
+            out.end[i] = pt.offset[id_end];
+        if(out.segments)
+            out.segments[i] = pt.nseg;
+        if(out.params)
+            out.params[i] = pt.nparam;
+        if(out.host_type)
+            out.host_type[i] = pt.host;
+        if(out.ec)
+            out.ec[i] = ec;
+    }
+    return good;
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,352 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_RESOLVE_IPP
+#define BOOST_URL_IMPL_RESOLVE_IPP
+
+#include <boost/url/resolve.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+
+// Returns 1 for ".", 2 for "..", else 0
+inline
+int
+dot_kind(
+    string_view s) noexcept
+{
+    if( s.size() == 1 &&
+        s[0] == '.')
+        return 1;
+    if( s.size() == 2 &&
+        s[0] == '.' &&
+        s[1] == '.')
+        return 2;
+    return 0;
+}
+
+// The segments of the merged path of rfc3986
+// section 5.2.3, visited from last to first:
+// those of the base path up to its last '/',
+// followed by those of the reference path.
+class merged_path
+{
+    string_view a_;
+    string_view b_;
+    bool a_done_;
+    bool b_done_ = false;
+    bool abs_;
+
+    // removes and returns the last segment
+    static
+    string_view
+    pop(
+        string_view& s,
+        bool& done) noexcept
+    {
+        auto const i = s.rfind('/');
+        if(i == string_view::npos)
+        {
+            done = true;
+            return s;
+        }
+        auto const r = s.substr(i + 1);
+        s = s.substr(0, i);
+        return r;
+    }
+
+public:
+    merged_path(
+        string_view prefix,
+        string_view path) noexcept
+    {
+        BOOST_ASSERT(! path.empty());
+        BOOST_ASSERT(prefix.empty() ||
+            prefix.back() == '/');
+        if(! prefix.empty())
+            abs_ = prefix.front() == '/';
+        else
+            abs_ = path.front() == '/';
+        if( ! prefix.empty() &&
+            prefix.front() == '/')
+            prefix.remove_prefix(1);
+        a_done_ = prefix.empty();
+        if(! a_done_)
+            a_ = prefix.substr(
+                0, prefix.size() - 1);
+        if(path.front() == '/')
+            path.remove_prefix(1);
+        b_ = path;
+    }
+
+    bool
+    is_absolute() const noexcept
+    {
+        return abs_;
+    }
+
+    // Sets s to the previous segment,
+    // returning false at the start
+    bool
+    prev(string_view& s) noexcept
+    {
+        if(! b_done_)
+        {
+            s = pop(b_, b_done_);
+            return true;
+        }
+        if(! a_done_)
+        {
+            s = pop(a_, a_done_);
+            return true;
+        }
+        return false;
+    }
+};
+
+// Calls f with each segment which remains after
+// removing dot segments as in rfc3986 section
+// 5.2.4, from last to first. Walking backwards,
+// a ".." only needs to count the segments it
+// removes, so no output has to be revisited.
+template<class F>
+void
+remove_dot_segments(
+    merged_path p,
+    F const& f)
+{
+    string_view s;
+    std::size_t skip = 0;
+    bool last = true;
+    while(p.prev(s))
+    {
+        auto const d = dot_kind(s);
+        // a trailing "." or ".."
+        // leaves an empty segment
+        if( last &&
+            d != 0)
+            f(string_view());
+        last = false;
+        if(d == 1)
+            continue;
+        if(d == 2)
+        {
+            ++skip;
+            continue;
+        }
+        if(skip > 0)
+        {
+            --skip;
+            continue;
+        }
+        f(s);
+    }
+}
+
+} // detail
+
+void
+resolve(
+    url_view const& base,
+    url_view const& ref,
+    url_base& dest,
+    error_code& ec)
+{
+    using namespace detail;
+    auto const& pb = base.pt_;
+    auto const& pr = ref.pt_;
+    if(pb.length(id_scheme) == 0)
+    {
+        ec = error::missing_scheme;
+        return;
+    }
+    ec = {};
+
+    // rfc3986 section 5.2.2
+    url_view const* scheme_from = &base;
+    url_view const* auth_from = &base;
+    url_view const* path_from = nullptr;
+    url_view const* query_from = &ref;
+    string_view prefix;
+    if(pr.length(id_scheme) != 0)
+    {
+        scheme_from = &ref;
+        auth_from = &ref;
+    }
+    else if(ref.has_authority())
+    {
+        auth_from = &ref;
+    }
+    else if(pr.length(id_path) == 0)
+    {
+        path_from = &base;
+        if(pr.length(id_query) == 0)
+            query_from = &base;
+    }
+    else if(ref.s_[pr.offset[
+        id_path]] != '/')
+    {
+        // merge
+        if( base.has_authority() &&
+            pb.length(id_path) == 0)
+        {
+            prefix = "/";
+        }
+        else
+        {
+            prefix = pb.get(
+                id_path, base.s_);
+            prefix = prefix.substr(0,
+                prefix.rfind('/') + 1);
+        }
+    }
+    if( path_from == nullptr &&
+        pr.length(id_path) == 0)
+        path_from = &ref;
+
+    // measure the path
+    std::size_t path_len = 0;
+    std::size_t nseg = 0;
+    std::size_t k = 0;
+    bool dot = false;
+    merged_path const mp(prefix,
+        path_from ? string_view("/") :
+            pr.get(id_path, ref.s_));
+    if(path_from)
+    {
+        path_len = path_from->pt_.length(
+            id_path);
+        nseg = path_from->pt_.nseg;
+    }
+    else
+    {
+        std::size_t n = 0;
+        bool front_empty = false;
+        remove_dot_segments(mp,
+            [&](string_view s)
+            {
+                n += s.size();
+                ++k;
+                front_empty = s.empty();
+            });
+        BOOST_ASSERT(k > 0);
+        // keep a leading empty segment from
+        // being read as an authority, or from
+        // making a relative path absolute
+        dot = k > 1 && front_empty && (
+            ! mp.is_absolute() ||
+            ! auth_from->has_authority());
+        if(dot)
+        {
+            ++n;
+            ++k;
+        }
+        path_len = mp.is_absolute() ?
+            n + k : n + k - 1;
+        nseg = k;
+        if(path_len == 0)
+            nseg = 0;
+        else if(
+            path_len == 1 &&
+            mp.is_absolute() &&
+            ! auth_from->has_authority())
+            nseg = 0;
+    }
+
+    auto const size =
+        scheme_from->pt_.length(id_scheme) +
+        auth_from->pt_.copied_length(
+            id_user, id_path) +
+        path_len +
+        query_from->pt_.length(id_query) +
+        pr.length(id_frag);
+    char* const s = dest.a_.resize(size);
+    //---
+    detail::parts pt;
+    char* w = s;
+    auto const put = [&](
+        url_view const& u,
+        int first,
+        int last)
+    {
+        w += copy_parts(pt, w, w - s,
+            u.pt_, u.s_, first, last);
+    };
+    put(*scheme_from, id_scheme, id_user);
+    put(*auth_from, id_user, id_path);
+    if(path_from)
+    {
+        put(*path_from, id_path, id_query);
+    }
+    else
+    {
+        // written from last to first,
+        // since the length is known
+        pt.offset[id_path] = w - s;
+        pt.set_pct(id_path,
+            pb.has_pct(id_path) ||
+            pr.has_pct(id_path));
+        auto e = w + path_len;
+        auto i = k;
+        remove_dot_segments(mp,
+            [&](string_view seg)
+            {
+                e -= seg.size();
+                if(! seg.empty())
+                    std::memcpy(e,
+                        seg.data(),
+                        seg.size());
+                --i;
+                if( mp.is_absolute() ||
+                    i > 0)
+                    *--e = '/';
+            });
+        if(dot)
+        {
+            *--e = '.';
+            if(mp.is_absolute())
+                *--e = '/';
+        }
+        BOOST_ASSERT(e == w);
+        w += path_len;
+    }
+    put(*query_from, id_query, id_frag);
+    put(ref, id_frag, id_end);
+    pt.offset[id_end] = w - s;
+    BOOST_ASSERT(pt.offset[
+        id_end] == size);
+
+    pt.scheme_id = scheme_from->pt_.scheme_id;
+    pt.assign_host(auth_from->pt_);
+    pt.port_number = auth_from->pt_.port_number;
+    pt.nseg = nseg;
+    pt.nparam = query_from->pt_.nparam;
+    dest.s_ = s;
+    dest.pt_ = pt;
+}
+
+void
+resolve(
+    url_view const& base,
+    url_view const& ref,
+    url_base& dest)
+{
+    error_code ec;
+    resolve(base, ref, dest, ec);
+    if(ec)
+        invalid_part::raise();
+}
+
+} // urls
+} // boost
+
+#endif
@@ -11,7 +11,6 @@
 #define BOOST_URL_IMPL_SCHEME_IPP
 
 #include <boost/url/scheme.hpp>
-#include <boost/url/detail/char_type.hpp>
 
 namespace boost {
 namespace urls {
@@ -20,71 +19,7 @@ scheme
 string_to_scheme(
     string_view s) noexcept
 {
-    using detail::to_lower;
-
-    switch(s.size())
-    {
-    case 2: // ws
-        if( tolower(s[0]) == 'w' &&
-            tolower(s[1]) == 's')
-            return scheme::ws;
-        break;
-
-    case 3:
-        switch(tolower(s[0]))
-        {
-        case 'w': // wss
-            if( tolower(s[1]) == 's' &&
-                tolower(s[2]) == 's')
-                return scheme::wss;
-            break;
-
-        case 'f': // ftp
-            if( tolower(s[1]) == 't' &&
-                tolower(s[2]) == 'p')
-                return scheme::ftp;
-            break;
-
-        default:
-            break;
-        }
-        break;
-
-    case 4:
-        switch(tolower(s[0]))
-        {
-        case 'f': // file
-            if( tolower(s[1]) == 'i' &&
-                tolower(s[2]) == 'l' &&
-                tolower(s[3]) == 'e')
-                return scheme::file;
-            break;
-
-        case 'h': // http
-            if( tolower(s[1]) == 't' &&
-                tolower(s[2]) == 't' &&
-                tolower(s[3]) == 'p')
-                return scheme::http;
-            break;
-
-        default:
-            break;
-        }
-        break;
-
-    case 5: // https
-        if( tolower(s[0]) == 'h' &&
-            tolower(s[1]) == 't' &&
-            tolower(s[2]) == 't' &&
-            tolower(s[3]) == 'p' &&
-            tolower(s[4]) == 's')
-            return scheme::https;
-        break;
-
-    default:
-        break;
-    }
-    return scheme::unknown;
+    return detail::get_scheme(s);
 }
 
 string_view
@@ -105,6 +40,23 @@ to_string(scheme s) noexcept
     return "<unknown>";
 }
 
+std::uint16_t
+default_port(scheme s) noexcept
+{
+    switch(s)
+    {
+    case scheme::ftp:   return 21;
+    case scheme::http:  return 80;
+    case scheme::https: return 443;
+    case scheme::ws:    return 80;
+    case scheme::wss:   return 443;
+
+    default:
+        break;
+    }
+    return 0;
+}
+
 } // urls
 } // boost
 
@@ -46,6 +46,17 @@ segments() const noexcept ->
     return url_view::segments_type(*this);
 }
 
+auto
+url_base::
+segments(
+    basic_segments_index& idx) const ->
+        url_view::indexed_segments_type
+{
+    idx.build(s_, pt_);
+    return url_view::indexed_segments_type(
+        s_, idx.v_, idx.n_);
+}
+
 auto
 url_base::
 segments() noexcept ->
@@ -103,6 +114,17 @@ params() const noexcept ->
     return url_view::params_type(*this);
 }
 
+auto
+url_base::
+params(
+    basic_params_index& idx) const ->
+        url_view::indexed_params_type
+{
+    idx.build(s_, pt_);
+    return url_view::indexed_params_type(
+        url_view::params_type(*this), idx);
+}
+
 auto
 url_base::
 params() noexcept ->
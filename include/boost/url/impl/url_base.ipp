@@ -58,25 +58,59 @@ encoded_origin() const noexcept
         s_);
 }
 
+url_base&
+url_base::
+assign(url_view const& v)
+{
+    auto const n = view_size(v);
+    if( s_ &&
+        n <= a_.capacity())
+    {
+        // v may refer to this URL, so the
+        // characters are moved before the
+        // storage writes the terminator
+        copy_view(s_, v);
+        s_ = a_.resize(n);
+        return *this;
+    }
+    auto const s = a_.resize_exact(n);
+    //---
+    copy_view(s, v);
+    return *this;
+}
+
 url_base&
 url_base::
 set_encoded_url(
     string_view s)
 {
+    error_code ec;
+    set_encoded_url(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_url(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         if(s_)
             resize(
                 detail::id_scheme,
                 detail::id_end, 0);
+        pt_ = detail::parts();
         return *this;
     }
-    error_code ec;
-    detail::parser pr(s);
     detail::parts pt;
     detail::parse_url(pt, s, ec);
     if(ec)
-        invalid_part::raise();
+        return *this;
     s_ = a_.resize(s.size());
     //---
     pt_ = pt;
@@ -90,19 +124,35 @@ url_base::
 set_encoded_origin(
     string_view s)
 {
+    error_code ec;
+    set_encoded_origin(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_origin(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         resize(
             detail::id_scheme,
             detail::id_path, 0);
+        pt_.assign_host(detail::parts());
+        pt_.scheme_id = urls::scheme::unknown;
+        pt_.port_number = 0;
         return *this;
     }
 
-    error_code ec;
     detail::parts pt;
     detail::parse_origin(pt, s, ec);
     if(ec)
-        invalid_part::raise();
+        return *this;
     auto const dest =
         resize(
             detail::id_scheme,
@@ -123,6 +173,9 @@ set_encoded_origin(
         pt.length(detail::id_host));
     pt_.split(
         detail::id_port, pt.length(detail::id_port));
+    pt_.assign_host(pt);
+    pt_.scheme_id = pt.scheme_id;
+    pt_.port_number = pt.port_number;
     return *this;
 }
 
@@ -151,19 +204,37 @@ url_base::
 set_scheme(
     string_view s)
 {
+    error_code ec;
+    set_scheme(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_scheme(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         resize(detail::id_scheme, 0);
+        pt_.scheme_id = urls::scheme::unknown;
         return *this;
     }
 
     detail::parts pr;
-    detail::parse_scheme(pr, s);
+    detail::parse_scheme(pr, s, ec);
+    if(ec)
+        return *this;
     auto const n = s.size();
     auto const dest =
         resize(detail::id_scheme, n + 1);
     s.copy(dest, n);
     dest[n] = ':';
+    pt_.scheme_id = pr.scheme_id;
     return *this;
 }
 
@@ -205,16 +276,34 @@ url_base::
 set_encoded_authority(
     string_view s)
 {
+    error_code ec;
+    set_encoded_authority(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_authority(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         resize(
             detail::id_user,
             detail::id_path, 0);
+        pt_.assign_host(detail::parts());
+        pt_.port_number = 0;
         return *this;
     }
 
     detail::parts pt;
-    detail::parse_authority(pt, s);
+    detail::parse_authority(pt, s, ec);
+    if(ec)
+        return *this;
     auto const dest = resize(
         detail::id_user,
         detail::id_path,
@@ -235,6 +324,8 @@ set_encoded_authority(
     BOOST_ASSERT(
         pt_.length(detail::id_port) ==
             pt.length(detail::id_port));
+    pt_.assign_host(pt);
+    pt_.port_number = pt.port_number;
     return *this;
 }
 
@@ -316,6 +407,20 @@ url_base::
 set_encoded_userinfo(
     string_view s)
 {
+    error_code ec;
+    set_encoded_userinfo(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_userinfo(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         if(pt_.length(
@@ -336,7 +441,9 @@ set_encoded_userinfo(
     }
 
     detail::parts pt;
-    detail::parse_userinfo(pt, s);
+    detail::parse_userinfo(pt, s, ec);
+    if(ec)
+        return *this;
     auto dest = resize(
         detail::id_user,
         detail::id_host,
@@ -357,13 +464,30 @@ url_base::
 set_userinfo_part(
     string_view s)
 {
+    error_code ec;
+    set_userinfo_part(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_userinfo_part(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(! s.empty())
     {
         if(s.back() != '@')
-            invalid_part::raise();
+        {
+            ec = error::syntax;
+            return *this;
+        }
         s.remove_suffix(1);
     }
-    return set_encoded_userinfo(s);
+    return set_encoded_userinfo(s, ec);
 }
 
 string_view
@@ -448,12 +572,28 @@ url_base::
 set_encoded_user(
     string_view s)
 {
+    error_code ec;
+    set_encoded_user(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_user(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
         return set_user(s);
 
     auto const e =
         detail::userinfo_nc_pct_set();
-    e.validate(s);
+    e.validate(s, ec);
+    if(ec)
+        return *this;
 
     auto const n = s.size();
     if(pt_.length(detail::id_password) != 0)
@@ -576,14 +716,33 @@ url_base::
 set_encoded_password(
     string_view s)
 {
+    error_code ec;
+    set_encoded_password(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_password(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
         return set_password(s);
 
     auto const e =
         detail::userinfo_pct_set();
     if(s[0] == ':')
-        invalid_part::raise();
-    e.validate(s);
+    {
+        ec = error::bad_userinfo_char;
+        return *this;
+    }
+    e.validate(s, ec);
+    if(ec)
+        return *this;
 
     auto const n = s.size();
     if(pt_.length(detail::id_user) != 0)
@@ -613,12 +772,29 @@ url_base::
 set_password_part(
     string_view s)
 {
+    error_code ec;
+    set_password_part(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_password_part(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
         return set_password(s);
+    if(s.front() != ':')
+    {
+        ec = error::syntax;
+        return *this;
+    }
     if(s.size() == 1)
     {
-        if(s.front() != ':')
-            invalid_part::raise();
         if(pt_.length(
             detail::id_user) != 0)
         {
@@ -637,10 +813,10 @@ set_password_part(
         dest[3] = '@';
         pt_.split(
             detail::id_user, 2);
+        return *this;
     }
-    set_encoded_password(
-        s.substr(1));
-    return *this;
+    return set_encoded_password(
+        s.substr(1), ec);
 }
 
 //----------------------------------------------------------
@@ -659,6 +835,28 @@ encoded_host_and_port() const noexcept
         s_);
 }
 
+urls::ipv4_address
+url_base::
+ipv4_address() const noexcept
+{
+    if(pt_.host != urls::host_type::ipv4)
+        return {};
+    urls::ipv4_address::bytes_type b;
+    std::memcpy(&b[0], pt_.ip, b.size());
+    return urls::ipv4_address(b);
+}
+
+urls::ipv6_address
+url_base::
+ipv6_address() const noexcept
+{
+    if(pt_.host != urls::host_type::ipv6)
+        return {};
+    urls::ipv6_address::bytes_type b;
+    std::memcpy(&b[0], pt_.ip, b.size());
+    return urls::ipv6_address(b);
+}
+
 string_view
 url_base::
 encoded_host() const noexcept
@@ -749,7 +947,7 @@ set_host(
             e.encode(dest, s);
         }
     }
-    pt_.host = pt.host;
+    pt_.assign_host(pt);
     return *this;
 }
 
@@ -758,10 +956,26 @@ url_base::
 set_encoded_host(
     string_view s)
 {
+    error_code ec;
+    set_encoded_host(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_host(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
         return set_host(s);
     detail::parts pt;
-    detail::parse_hostname(pt, s);
+    detail::parse_hostname(pt, s, ec);
+    if(ec)
+        return *this;
     if(! has_authority())
     {
         // add authority
@@ -783,7 +997,7 @@ set_encoded_host(
             s.size());
         s.copy(dest, s.size());
     }
-    pt_.host = pt.host;
+    pt_.assign_host(pt);
     return *this;
 }
 
@@ -823,8 +1037,23 @@ set_port(unsigned n)
 
 url_base&
 url_base::
-set_port(string_view s)
+set_port(
+    string_view s)
 {
+    error_code ec;
+    set_port(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_port(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         // just port
@@ -844,9 +1073,13 @@ set_port(string_view s)
         {
             resize(detail::id_port, 0);
         }
+        pt_.port_number = 0;
         return *this;
     }
-    detail::match_port(s);
+    auto const n =
+        detail::match_port(s, ec);
+    if(ec)
+        return *this;
     if(! has_authority())
     {
         // add authority
@@ -872,24 +1105,41 @@ set_port(string_view s)
         dest[0] = ':';
         s.copy(dest + 1, s.size());
     }
+    pt_.port_number = n;
+    return *this;
+}
+
+url_base&
+url_base::
+set_port_part(
+    string_view s)
+{
+    error_code ec;
+    set_port_part(s, ec);
+    if(ec)
+        invalid_part::raise();
     return *this;
 }
 
 url_base&
 url_base::
-set_port_part(string_view s)
+set_port_part(
+    string_view s,
+    error_code& ec)
 {
+    ec = {};
     if(s.empty())
+        return set_port(s, ec);
+    if(s.front() != ':')
     {
-        set_port(s);
+        ec = error::syntax;
         return *this;
     }
-    if(s.front() != ':')
-        invalid_part::raise();
     if(s.size() > 1)
-        return set_port(s.substr(1));
+        return set_port(s.substr(1), ec);
     resize(
         detail::id_port, 1)[0] = ':';
+    pt_.port_number = 0;
     return *this;
 }
 
@@ -913,36 +1163,55 @@ url_base::
 set_encoded_path(
     string_view s)
 {
+    error_code ec;
+    set_encoded_path(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_path(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     // path-empty
     if(s.empty())
     {
         resize(
             detail::id_path, 0);
+        pt_.nseg = 0;
         return *this;
     }
+    std::size_t nseg;
     if(has_authority())
     {
         // path-abempty
-        detail::match_path_abempty(s);
+        nseg = detail::match_path_abempty(s, ec);
     }
     else if(s.front() == '/')
     {
         // path-absolute
-        detail::match_path_absolute(s);
+        nseg = detail::match_path_absolute(s, ec);
     }
     else if(pt_.length(
         detail::id_scheme) == 0)
     {
         // path-noscheme
-        detail::match_path_noscheme(s);
+        nseg = detail::match_path_noscheme(s, ec);
     }
     else
     {
         // path-rootless
-        detail::match_path_rootless(s);
+        nseg = detail::match_path_rootless(s, ec);
     }
+    if(ec)
+        return *this;
     auto const dest = resize(
         detail::id_path, s.size());
+    pt_.nseg = nseg;
     s.copy(dest, s.size());
     return *this;
 }
@@ -987,6 +1256,7 @@ set_query(
     if(s.empty())
     {
         resize(detail::id_query, 0);
+        pt_.nparam = 0;
         return *this;
     }
     auto const e =
@@ -998,6 +1268,8 @@ set_query(
         1 + n);
     dest[0] = '?';
     e.encode(dest + 1, s);
+    pt_.nparam = detail::count_params(
+        pt_.get(detail::id_query, s_));
     return *this;
 }
 
@@ -1006,19 +1278,38 @@ url_base::
 set_encoded_query(
     string_view s)
 {
+    error_code ec;
+    set_encoded_query(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_query(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         resize(detail::id_query, 0);
+        pt_.nparam = 0;
         return *this;
     }
     auto const e =
         detail::query_pct_set();
-    e.validate(s);
+    e.validate(s, ec);
+    if(ec)
+        return *this;
     auto const dest = resize(
         detail::id_query,
         1 + s.size());
     dest[0] = '?';
     s.copy(dest + 1, s.size());
+    pt_.nparam = detail::count_params(
+        pt_.get(detail::id_query, s_));
     return *this;
 }
 
@@ -1027,22 +1318,44 @@ url_base::
 set_query_part(
     string_view s)
 {
+    error_code ec;
+    set_query_part(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_query_part(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         resize(detail::id_query, 0);
+        pt_.nparam = 0;
         return *this;
     }
     if(s.front() != '?')
-        invalid_part::raise();
+    {
+        ec = error::syntax;
+        return *this;
+    }
     s = s.substr(1);
     auto const e =
         detail::query_pct_set();
-    e.validate(s);
+    e.validate(s, ec);
+    if(ec)
+        return *this;
     auto const dest = resize(
         detail::id_query,
         1 + s.size());
     dest[0] = '?';
     s.copy(dest + 1, s.size());
+    pt_.nparam = detail::count_params(
+        pt_.get(detail::id_query, s_));
     return *this;
 }
 
@@ -1104,6 +1417,20 @@ url_base::
 set_encoded_fragment(
     string_view s)
 {
+    error_code ec;
+    set_encoded_fragment(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_fragment(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         resize(detail::id_frag, 0);
@@ -1111,7 +1438,9 @@ set_encoded_fragment(
     }
     auto const e =
         detail::frag_pct_set();
-    e.validate(s);
+    e.validate(s, ec);
+    if(ec)
+        return *this;
     auto const dest = resize(
         detail::id_frag,
         1 + s.size());
@@ -1125,17 +1454,36 @@ url_base::
 set_fragment_part(
     string_view s)
 {
+    error_code ec;
+    set_fragment_part(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_fragment_part(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         resize(detail::id_frag, 0);
         return *this;
     }
     if(s.front() != '#')
-        invalid_part::raise();
+    {
+        ec = error::syntax;
+        return *this;
+    }
     s = s.substr(1);
     auto const e =
         detail::frag_pct_set();
-    e.validate(s);
+    e.validate(s, ec);
+    if(ec)
+        return *this;
     auto const dest = resize(
         detail::id_frag,
         1 + s.size());
@@ -1146,11 +1494,215 @@ set_fragment_part(
 
 //----------------------------------------------------------
 
+namespace detail {
+
+// Copies [p, end) to dest with escaped unreserved
+// characters decoded and the hex digits of other
+// escapes in upper case, folding unescaped letters
+// to lower case when lower is set. The output is
+// never longer, so dest may equal p.
+inline
+char*
+normalize_escapes(
+    char* dest,
+    char const* p,
+    char const* end,
+    bool lower) noexcept
+{
+    static constexpr char hex[] =
+        "0123456789ABCDEF";
+    while(p < end)
+    {
+        char c = *p;
+        if(c != '%')
+        {
+            *dest++ = lower ? to_lower(c) : c;
+            ++p;
+            continue;
+        }
+        auto const u = static_cast<
+            unsigned char>(
+            (static_cast<unsigned char>(
+                hex_digit(p[1])) << 4) +
+            static_cast<unsigned char>(
+                hex_digit(p[2])));
+        p += 3;
+        c = static_cast<char>(u);
+        if(is_unreserved(c))
+        {
+            *dest++ = lower ? to_lower(c) : c;
+            continue;
+        }
+        dest[0] = '%';
+        dest[1] = hex[u >> 4];
+        dest[2] = hex[u & 0xf];
+        dest += 3;
+    }
+    return dest;
+}
+
+// Copies the absolute path [p, end) to dest
+// as normalize_escapes does, removing dot
+// segments as in rfc3986 section 5.2.4.
+inline
+char*
+normalize_path(
+    char* dest,
+    char const* p,
+    char const* end) noexcept
+{
+    BOOST_ASSERT(*p == '/');
+    auto const begin = dest;
+    while(p < end)
+    {
+        auto q = p + 1;
+        while(
+            q < end &&
+            *q != '/')
+            ++q;
+        auto const seg = dest;
+        *dest++ = '/';
+        dest = normalize_escapes(
+            dest, p + 1, q, false);
+        p = q;
+        auto const n = dest - seg - 1;
+        if( (n != 1 && n != 2) ||
+            seg[1] != '.' ||
+            (n == 2 && seg[2] != '.'))
+            continue;
+        dest = seg;
+        if(n == 2)
+        {
+            // remove the previous segment
+            while(
+                dest > begin &&
+                *--dest != '/')
+            {
+            }
+        }
+        // a trailing "." or ".."
+        // leaves an empty segment
+        if(p == end)
+            *dest++ = '/';
+    }
+    return dest;
+}
+
+} // detail
+
 url_base&
 url_base::
 normalize()
 {
     normalize_scheme();
+    if(size() == 0)
+        return *this;
+    auto const auth = has_authority();
+    auto const old = pt_;
+
+    // Every step only shrinks the string, so it
+    // is rewritten in place from left to right.
+    // Components which need no change are not
+    // copied but accumulated in a run [run, p),
+    // which is moved down once, when the next
+    // rewritten component or the end is reached.
+    char* w = s_ + old.offset[
+        detail::id_user];
+    char const* p = w;
+    char const* run = p;
+    auto const flush = [&]
+    {
+        auto const n = p - run;
+        if(w != run)
+            std::memmove(w, run, n);
+        w += n;
+    };
+    for(int id = detail::id_user;
+        id < detail::id_end; ++id)
+    {
+        char const* const end =
+            s_ + old.offset[id + 1];
+        pt_.offset[id] = (w - s_) + (p - run);
+        switch(id)
+        {
+        case detail::id_user:
+        case detail::id_password:
+        case detail::id_query:
+        case detail::id_frag:
+            if(! old.has_pct(id))
+                break;
+            flush();
+            w = detail::normalize_escapes(
+                w, p, end, false);
+            run = end;
+            break;
+
+        case detail::id_host:
+            if( old.host == host_type::none ||
+                old.host == host_type::ipv4)
+                break;
+            flush();
+            w = detail::normalize_escapes(
+                w, p, end, true);
+            run = end;
+            break;
+
+        case detail::id_port:
+            // an empty port is removed
+            if(end - p != 1)
+                break;
+            flush();
+            run = end;
+            break;
+
+        case detail::id_path:
+        {
+            if( ! old.has_pct(id) &&
+                std::memchr(p, '.',
+                    end - p) == nullptr)
+                break;
+            flush();
+            auto const dest = w;
+            if( p == end ||
+                *p != '/')
+            {
+                w = detail::normalize_escapes(
+                    w, p, end, false);
+                run = end;
+                break;
+            }
+            w = detail::normalize_path(
+                w, p, end);
+            if( ! auth &&
+                w - dest > 1 &&
+                dest[1] == '/')
+            {
+                // keep "//" from being read
+                // as an authority: "/.//"
+                BOOST_ASSERT(w + 2 <= end);
+                std::memmove(dest + 2,
+                    dest, w - dest);
+                dest[1] = '.';
+                w += 2;
+            }
+            std::size_t nseg = 0;
+            for(auto it = dest; it < w; ++it)
+                if(*it == '/')
+                    ++nseg;
+            if( ! auth &&
+                w - dest == 1)
+                nseg = 0;
+            pt_.nseg = nseg;
+            run = end;
+            break;
+        }
+        }
+        p = end;
+    }
+    flush();
+    pt_.offset[detail::id_end] = w - s_;
+    *w = '\0';
+    s_ = a_.resize(size());
     return *this;
 }
 
@@ -1233,7 +1785,9 @@ operator*() const noexcept ->
     if(! s.empty() &&
         s.front() == '/')
         s = s.substr(1);
-    return value_type(s);
+    return value_type(s,
+        v_->pt_.has_pct(
+            detail::id_path));
 }
 
 auto
@@ -1245,10 +1799,10 @@ operator++() noexcept ->
 {
     BOOST_ASSERT(
         off_ != v_->pt_.offset[
-            detail::id_frag]);
+            detail::id_query]);
     off_ = off_ + n_;
     if(off_ == v_->pt_.offset[
-        detail::id_frag])
+        detail::id_query])
     {
         // end
         n_ = 0;
@@ -1297,14 +1851,17 @@ segments_type::
 iterator::
 parse() noexcept
 {
-    BOOST_ASSERT(off_ !=
-        v_->pt_.offset[
-            detail::id_frag]);
     auto const end =
         v_->s_ + v_->pt_.offset[
             detail::id_query];
     auto const p0 =
         v_->s_ + off_;
+    if(p0 == end)
+    {
+        // end
+        n_ = 0;
+        return;
+    }
     auto p = p0;
     if(*p == '/')
         ++p;
@@ -1399,6 +1956,7 @@ insert_encoded_impl( iterator pos, string_view s ) ->
     auto const n = s.size() + 1;
     v.s_ = v.a_.resize(v.size() + n);
     v.pt_.resize(detail::id_path, v.pt_.length(detail::id_path, detail::id_query) + n);
+    v.pt_.set_pct(detail::id_path, true);
     std::memmove(v.s_ + v.pt_.offset[detail::id_end] + pos.off_ - n0, v.s_ + pos.off_, n0 - pos.off_ + 1);
     BOOST_ASSERT(v.s_[v.pt_.offset[detail::id_end]] == '\0');
     v.s_[pos.off_] = '/';
@@ -1427,6 +1985,7 @@ insert_impl( iterator pos, string_view s, std::size_t const ns ) ->
     auto const n = ns + 1;
     v.s_ = v.a_.resize(v.size() + n);
     v.pt_.resize(detail::id_path, v.pt_.length(detail::id_path, detail::id_query) + n);
+    v.pt_.set_pct(detail::id_path, true);
     std::memmove(v.s_ + v.pt_.offset[detail::id_end] + pos.off_ - n0, v.s_ + pos.off_, n0 - pos.off_ + 1);
     BOOST_ASSERT(v.s_[v.pt_.offset[detail::id_end]] == '\0');
     v.s_[pos.off_] = '/';
@@ -1512,6 +2071,7 @@ iterator() noexcept
     , off_(0)
     , nk_(0)
     , nv_(0)
+    , pct_(0)
 {
 }
 
@@ -1528,6 +2088,7 @@ iterator(
         off_ = 0;
         nk_ = 0;
         nv_ = 0;
+        pct_ = 0;
     }
     else if( end ||
             v_->pt_.nparam == 0)
@@ -1536,6 +2097,7 @@ iterator(
             detail::id_frag];
         nk_ = 0;
         nv_ = 0;
+        pct_ = 0;
     }
     else
     {
@@ -1564,13 +2126,13 @@ operator*() const noexcept ->
         v_->s_ + off_ + 1,
         nk_ - 1 };
     if(nv_ == 0)
-        return { k, { } };
+        return { k, { }, pct_ };
     BOOST_ASSERT(
         v_->s_[off_ + nk_] == '=');
     string_view const v = {
         v_->s_ + off_ + nk_ + 1,
         nv_ - 1};
-    return { k, v };
+    return { k, v, pct_ };
 }
 
 auto
@@ -1627,6 +2189,7 @@ operator--() noexcept ->
     }
     BOOST_ASSERT(*p == '?');
     off_ = p - v_->s_;
+    parse();
     return *this;
 }
 
@@ -1640,7 +2203,7 @@ parse() noexcept
     BOOST_ASSERT(v_->pt_.nparam > 0);
     auto const end =
         v_->s_ + v_->pt_.offset[
-            detail::id_end];
+            detail::id_frag];
     char const* p = v_->s_ + off_;
     BOOST_ASSERT(
         ( off_ == v_->pt_.offset[
@@ -1652,22 +2215,27 @@ parse() noexcept
     auto p0 = p++;
     auto const ek =
         detail::qkey_pct_set();
-    error_code ec;
-    p = ek.parse(p, end, ec);
+    detail::error_value ec;
+    bool pk = false;
+    p = ek.parse(p, end, ec, pk);
     BOOST_ASSERT(! ec);
     nk_ = p - p0;
-    if(p == end)
+    pct_ = pk;
+    if( p == end ||
+        *p != '=')
     {
         nv_ = 0;
         return;
     }
     auto const ev =
         detail::qval_pct_set();
-    BOOST_ASSERT(*p == '=');
     p0 = p++;
-    p = ev.parse(p, end, ec);
+    bool pv = false;
+    p = ev.parse(p, end, ec, pv);
     BOOST_ASSERT(! ec);
     nv_ = p - p0;
+    pct_ = static_cast<
+        unsigned char>(pk + 2 * pv);
 }
 
 //----------------------------------------------------------
@@ -1746,12 +2314,41 @@ operator[](string_view key) const
 
 //----------------------------------------------------------
 
+std::size_t
+url_base::
+view_size(
+    url_view const& v) noexcept
+{
+    return v.pt_.copied_length(
+        detail::id_scheme,
+        detail::id_end);
+}
+
+void
+url_base::
+copy_view(
+    char* s,
+    url_view const& v) noexcept
+{
+    auto const pt = v.pt_;
+    pt_ = pt;
+    pt_.offset[detail::id_end] =
+        detail::copy_parts(
+            pt_, s, 0, pt, v.s_,
+            detail::id_scheme,
+            detail::id_end);
+    s_ = s;
+}
+
 char*
 url_base::
 resize(
     int id,
     std::size_t new_size)
 {
+    // the caller writes the new
+    // contents, which may have escapes
+    pt_.set_pct(id, true);
     auto const len = pt_.length(id);
     if(len == new_size)
         return s_ + pt_.offset[id];
@@ -1801,6 +2398,8 @@ resize(
     int last,
     std::size_t new_size)
 {
+    for(auto i = first; i < last; ++i)
+        pt_.set_pct(i, true);
     auto const len =
         pt_.length(first, last);
     if(new_size == 0 && len == 0)
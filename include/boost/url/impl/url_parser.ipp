@@ -0,0 +1,368 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_URL_PARSER_IPP
+#define BOOST_URL_IMPL_URL_PARSER_IPP
+
+#include <boost/url/url_parser.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/detail/parse.hpp>
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+
+// true if [p, end) holds a character
+// which can't appear in an authority
+inline
+bool
+has_authority_end(
+    char const* p,
+    char const* const end) noexcept
+{
+    auto const e = pchar_pct_set();
+    while(p < end)
+    {
+        auto const c = *p++;
+        if( e.is_special(c) &&
+            c != '%' &&
+            c != '[' &&
+            c != ']')
+            return true;
+    }
+    return false;
+}
+
+} // detail
+
+void
+url_parser::
+reset() noexcept
+{
+    *this = url_parser();
+}
+
+std::size_t
+url_parser::
+write(
+    string_view s,
+    error_code& ec) noexcept
+{
+    step(s, false, ec);
+    return pos_;
+}
+
+url_view
+url_parser::
+finish(
+    string_view s,
+    error_code& ec) noexcept
+{
+    step(s, true, ec);
+    if(ec)
+        return {};
+    return url_view(s.data(), pt_);
+}
+
+void
+url_parser::
+end_path(char const* begin) noexcept
+{
+    using namespace detail;
+    parser pr(begin, begin + pos_);
+    pr.p_ = pr.end_;
+    pr.mark(pt_, id_path);
+    switch(kind_)
+    {
+    case path_kind::abempty:
+        pt_.nseg = nslash_;
+        break;
+    case path_kind::absolute:
+        pt_.nseg = (pt_.length(
+            id_path) > 1) ? nslash_ : 0;
+        break;
+    default:
+        pt_.nseg = (pt_.length(
+            id_path) > 0) ? nslash_ + 1 : 0;
+        break;
+    }
+}
+
+void
+url_parser::
+step(
+    string_view s,
+    bool eof,
+    error_code& ec) noexcept
+{
+    using namespace detail;
+    ec = {};
+    BOOST_ASSERT(pos_ <= s.size());
+    auto const begin = s.data();
+    auto const end = begin + s.size();
+    for(;;)
+    {
+        auto p = begin + pos_;
+        switch(st_)
+        {
+        case state::scheme:
+        {
+            // scheme ":" or relative-ref
+            auto q = begin + scan_;
+            if(q == begin)
+            {
+                if(q == end)
+                {
+                    if(! eof)
+                        goto need_more;
+                    relative_ = true;
+                    st_ = state::hier;
+                    break;
+                }
+                if(! is_alpha(*q))
+                {
+                    relative_ = true;
+                    st_ = state::hier;
+                    break;
+                }
+                ++q;
+            }
+            while(q < end)
+            {
+                if(! is_scheme_char(*q))
+                    break;
+                ++q;
+            }
+            scan_ = q - begin;
+            if(q == end && ! eof)
+                goto need_more;
+            if(q < end && *q == ':')
+            {
+                parser pr(begin, end);
+                pr.p_ = q + 1;
+                pr.mark(pt_, id_scheme);
+                pos_ = scan_ + 1;
+            }
+            else
+            {
+                relative_ = true;
+            }
+            st_ = state::hier;
+            break;
+        }
+
+        case state::hier:
+        {
+            auto const n = end - p;
+            if( ! eof && (n == 0 ||
+                (n == 1 && *p == '/')))
+                goto need_more;
+            if( n >= 2 &&
+                p[0] == '/' &&
+                p[1] == '/')
+            {
+                pos_ += 2;
+                st_ = state::authority;
+                break;
+            }
+            if(n > 0 && *p == '/')
+                kind_ = path_kind::absolute;
+            else if(relative_)
+                kind_ = path_kind::noscheme;
+            else
+                kind_ = path_kind::rootless;
+            first_ = true;
+            nslash_ = 0;
+            st_ = state::path;
+            break;
+        }
+
+        case state::authority:
+        {
+            // Work on a copy, since an
+            // authority which is cut short
+            // is parsed again later. The
+            // result is final only when the
+            // character ending the authority
+            // has been seen, usually the one
+            // where the parser stopped.
+            auto pt = pt_;
+            parser pr(begin, end);
+            pr.p_ = p;
+            error_value e;
+            pr.parse_authority(pt, e);
+            if( ! eof && ! has_authority_end(
+                    e ? p : pr.p_, end))
+                goto need_more;
+            if(e)
+            {
+                ec = e;
+                return;
+            }
+            pt_ = pt;
+            pos_ = pr.p_ - begin;
+            kind_ = path_kind::abempty;
+            first_ = true;
+            nslash_ = 0;
+            st_ = state::path;
+            break;
+        }
+
+        case state::path:
+        {
+            for(;;)
+            {
+                if(p == end)
+                {
+                    pos_ = p - begin;
+                    if(! eof)
+                        goto need_more;
+                    end_path(begin);
+                    st_ = state::done;
+                    return;
+                }
+                if(*p == '/')
+                {
+                    ++nslash_;
+                    first_ = false;
+                    ++p;
+                    continue;
+                }
+                // path-abempty
+                // begins with '/'
+                if( first_ && kind_ ==
+                        path_kind::abempty)
+                    break;
+                auto const e =
+                    (first_ && kind_ ==
+                        path_kind::noscheme) ?
+                    pchar_nc_pct_set() :
+                    pchar_pct_set();
+                auto const q =
+                    e.parse(p, end, ec);
+                if(ec)
+                {
+                    pos_ = q - begin;
+                    goto escape;
+                }
+                if(q == p)
+                    break;
+                p = q;
+            }
+            pos_ = p - begin;
+            end_path(begin);
+            if(*p == '?')
+            {
+                nparam_ = 1;
+                st_ = state::query_key;
+                break;
+            }
+            if(*p == '#')
+            {
+                ++pos_;
+                st_ = state::fragment;
+                break;
+            }
+            st_ = state::done;
+            return;
+        }
+
+        case state::query_key:
+        case state::query_value:
+        {
+            auto const ek = qkey_pct_set();
+            auto const ev = qval_pct_set();
+            for(;;)
+            {
+                auto const q = (st_ ==
+                    state::query_key ?
+                        ek : ev).parse(
+                            p, end, ec);
+                pos_ = q - begin;
+                if(ec)
+                    goto escape;
+                p = q;
+                if(p == end)
+                {
+                    if(! eof)
+                        goto need_more;
+                    break;
+                }
+                if(st_ == state::query_key)
+                {
+                    // a key may have no value
+                    if(*p == '&')
+                        ++nparam_;
+                    else if(*p == '=')
+                        st_ = state::query_value;
+                    else
+                        break;
+                }
+                else
+                {
+                    if(*p != '&')
+                        break;
+                    ++nparam_;
+                    st_ = state::query_key;
+                }
+                ++p;
+            }
+            parser pr(begin, end);
+            pr.p_ = p;
+            pr.mark(pt_, id_query);
+            pt_.nparam = nparam_;
+            if(p < end && *p == '#')
+            {
+                ++pos_;
+                st_ = state::fragment;
+                break;
+            }
+            st_ = state::done;
+            return;
+        }
+
+        case state::fragment:
+        {
+            auto const e = frag_pct_set();
+            auto const q =
+                e.parse(p, end, ec);
+            pos_ = q - begin;
+            if(ec)
+                goto escape;
+            if(q == end && ! eof)
+                goto need_more;
+            parser pr(begin, end);
+            pr.p_ = q;
+            pr.mark(pt_, id_frag);
+            st_ = state::done;
+            return;
+        }
+
+        case state::done:
+            return;
+        }
+    }
+
+escape:
+    // an escape cut off by the
+    // end of the input so far
+    if( ! eof && ec ==
+        error::incomplete_pct_encoding)
+        goto need_more;
+    return;
+
+need_more:
+    ec = error::need_more;
+}
+
+} // urls
+} // boost
+
+#endif
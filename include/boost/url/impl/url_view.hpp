@@ -73,6 +73,58 @@ segments() const noexcept ->
     return segments_type(*this);
 }
 
+auto
+url_view::
+segments(
+    basic_segments_index& idx) const ->
+        indexed_segments_type
+{
+    idx.build(s_, pt_);
+    return indexed_segments_type(
+        s_, idx.v_, idx.n_);
+}
+
+//----------------------------------------------------------
+
+auto
+url_view::
+indexed_segments_type::
+get(char const* s,
+    std::size_t const* v) noexcept ->
+        segments_type::value_type
+{
+    // offsets are shifted left, with
+    // the low bit set for escapes
+    auto const off = v[0] >> 1;
+    string_view t(
+        s + off, (v[1] >> 1) - off);
+    if(! t.empty() &&
+        t.front() == '/')
+        t.remove_prefix(1);
+    return value_type(
+        t, (v[0] & 1) != 0);
+}
+
+auto
+url_view::
+indexed_segments_type::
+begin() const noexcept ->
+    iterator
+{
+    return iterator(s_, v_);
+}
+
+auto
+url_view::
+indexed_segments_type::
+end() const noexcept ->
+    iterator
+{
+    return iterator(s_, v_ + n_);
+}
+
+//----------------------------------------------------------
+
 auto
 url_view::
 params() const noexcept ->
@@ -81,6 +133,30 @@ params() const noexcept ->
     return params_type(*this);
 }
 
+auto
+url_view::
+params(
+    basic_params_index& idx) const ->
+        indexed_params_type
+{
+    idx.build(s_, pt_);
+    return indexed_params_type(
+        params_type(*this), idx);
+}
+
+template<class Allocator>
+string_type<Allocator>
+url_view::
+indexed_params_type::
+at( string_view key,
+    Allocator const& a) const
+{
+    auto const it = find(key);
+    if(it == end())
+        out_of_range::raise();
+    return it->value(a);
+}
+
 } // urls
 } // boost
 
@@ -13,6 +13,7 @@
 #include <boost/url/url_view.hpp>
 #include <boost/url/error.hpp>
 #include <boost/url/detail/parse.hpp>
+#include <cstring>
 
 namespace boost {
 namespace urls {
@@ -91,7 +92,9 @@ encoded_authority() const noexcept
         detail::id_user,
         detail::id_path,
         s_);
-    if(! s.empty())
+    // authority-form has no "//"
+    if(pt_.length(
+        detail::id_user) != 0)
     {
         BOOST_ASSERT(s.size() >= 2);
         BOOST_ASSERT(
@@ -232,6 +235,28 @@ encoded_host_and_port() const noexcept
         s_);
 }
 
+urls::ipv4_address
+url_view::
+ipv4_address() const noexcept
+{
+    if(pt_.host != urls::host_type::ipv4)
+        return {};
+    urls::ipv4_address::bytes_type b;
+    std::memcpy(&b[0], pt_.ip, b.size());
+    return urls::ipv4_address(b);
+}
+
+urls::ipv6_address
+url_view::
+ipv6_address() const noexcept
+{
+    if(pt_.host != urls::host_type::ipv6)
+        return {};
+    urls::ipv6_address::bytes_type b;
+    std::memcpy(&b[0], pt_.ip, b.size());
+    return urls::ipv6_address(b);
+}
+
 string_view
 url_view::
 encoded_host() const noexcept
@@ -402,7 +427,9 @@ operator*() const noexcept ->
     if(! s.empty() &&
         s.front() == '/')
         s = s.substr(1);    
-    return value_type(s);
+    return value_type(s,
+        pt_->has_pct(
+            detail::id_path));
 }
 
 auto
@@ -414,10 +441,10 @@ operator++() noexcept ->
 {
     BOOST_ASSERT(
         off_ != pt_->offset[
-            detail::id_frag]);
+            detail::id_query]);
     off_ = off_ + n_;
     if(off_ == pt_->offset[
-        detail::id_frag])
+        detail::id_query])
     {
         // end
         n_ = 0;
@@ -468,10 +495,10 @@ parse() noexcept
 {
     BOOST_ASSERT(off_ !=
         pt_->offset[
-            detail::id_frag]);
+            detail::id_query]);
     auto const end =
         s_ + pt_->offset[
-            detail::id_frag];
+            detail::id_query];
     auto const p0 = s_ + off_;
     auto p = p0;
     if(*p == '/')
@@ -520,6 +547,7 @@ iterator() noexcept
     , off_(0)
     , nk_(0)
     , nv_(0)
+    , pct_(0)
 {
 }
 
@@ -537,6 +565,7 @@ iterator(
         off_ = 0;
         nk_ = 0;
         nv_ = 0;
+        pct_ = 0;
     }
     else if( end ||
             pt_->nparam == 0)
@@ -545,6 +574,7 @@ iterator(
             detail::id_frag];
         nk_ = 0;
         nv_ = 0;
+        pct_ = 0;
     }
     else
     {
@@ -573,13 +603,13 @@ operator*() const noexcept ->
         s_ + off_ + 1,
         nk_ - 1 };
     if(nv_ == 0)
-        return { k, { } };
+        return { k, { }, pct_ };
     BOOST_ASSERT(
         s_[off_ + nk_] == '=');
     string_view const v = {
         s_ + off_ + nk_ + 1,
         nv_ - 1};
-    return { k, v };
+    return { k, v, pct_ };
 }
 
 auto
@@ -636,6 +666,7 @@ operator--() noexcept ->
     }
     BOOST_ASSERT(*p == '?');
     off_ = p - s_;
+    parse();
     return *this;
 }
 
@@ -649,7 +680,7 @@ parse() noexcept
     BOOST_ASSERT(pt_->nparam > 0);
     auto const end =
         s_ + pt_->offset[
-            detail::id_end];
+            detail::id_frag];
     auto p = s_ + off_;
     BOOST_ASSERT(
         ( off_ == pt_->offset[
@@ -661,22 +692,27 @@ parse() noexcept
     auto p0 = p++;
     auto const ek =
         detail::qkey_pct_set();
-    error_code ec;
-    p = ek.parse(p, end, ec);
+    detail::error_value ec;
+    bool pk = false;
+    p = ek.parse(p, end, ec, pk);
     BOOST_ASSERT(! ec);
     nk_ = p - p0;
-    if(p == end)
+    pct_ = pk;
+    if( p == end ||
+        *p != '=')
     {
         nv_ = 0;
         return;
     }
     auto const ev =
         detail::qval_pct_set();
-    BOOST_ASSERT(*p == '=');
     p0 = p++;
-    p = ev.parse(p, end, ec);
+    bool pv = false;
+    p = ev.parse(p, end, ec, pv);
     BOOST_ASSERT(! ec);
     nv_ = p - p0;
+    pct_ = static_cast<
+        unsigned char>(pk + 2 * pv);
 }
 
 //----------------------------------------------------------
@@ -753,6 +789,66 @@ operator[](string_view key) const
     return it->value();
 }
 
+//----------------------------------------------------------
+//
+// indexed_params_type
+//
+//----------------------------------------------------------
+
+bool
+url_view::
+indexed_params_type::
+contains(string_view key) const noexcept
+{
+    return find(key) != end();
+}
+
+std::size_t
+url_view::
+indexed_params_type::
+count(string_view key) const noexcept
+{
+    if(! idx_)
+        return 0;
+    auto const h =
+        detail::key_hash(key);
+    auto i = h & idx_->mask_;
+    std::size_t n = 0;
+    while(idx_->find(
+        i, h, key, p_.s_))
+        ++n;
+    return n;
+}
+
+auto
+url_view::
+indexed_params_type::
+find(string_view key) const noexcept ->
+    iterator
+{
+    if(! idx_)
+        return end();
+    auto const h =
+        detail::key_hash(key);
+    auto i = h & idx_->mask_;
+    auto const e = idx_->find(
+        i, h, key, p_.s_);
+    if(! e)
+        return end();
+    return iterator(&p_, e);
+}
+
+std::string
+url_view::
+indexed_params_type::
+operator[](string_view key) const
+{
+    auto const it = find(key);
+    if(it == end())
+        return "";
+    return it->value();
+}
+
 } // urls
 } // boost
 
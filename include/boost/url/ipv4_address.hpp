@@ -0,0 +1,164 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IPV4_ADDRESS_HPP
+#define BOOST_URL_IPV4_ADDRESS_HPP
+
+#include <boost/url/config.hpp>
+#include <array>
+#include <cstdint>
+
+namespace boost {
+namespace urls {
+
+/** An IP version 4 address.
+
+    Objects of this type are returned by
+    @ref url_view::ipv4_address and
+    @ref url_base::ipv4_address, holding the
+    binary address recorded when the host
+    was parsed.
+
+    @par Example
+    @code
+    url_view u( "http://192.168.0.1/" );
+    assert( u.ipv4_address().to_uint() == 0xc0a80001 );
+    @endcode
+*/
+class ipv4_address
+{
+public:
+    /** The type used to represent an address as an array of bytes.
+    */
+    using bytes_type =
+        std::array<unsigned char, 4>;
+
+    /** The largest number of characters in a formatted address.
+    */
+    static constexpr
+        std::size_t max_str_len = 15;
+
+    /** Constructor.
+
+        Default constructed objects
+        hold the unspecified address
+        `0.0.0.0`.
+    */
+    ipv4_address() = default;
+
+    /** Constructor.
+
+        @param bytes The address in
+        network byte order.
+    */
+    explicit
+    ipv4_address(
+        bytes_type const& bytes) noexcept
+        : addr_(bytes)
+    {
+    }
+
+    /** Constructor.
+
+        @param u The address in host
+        byte order.
+    */
+    explicit
+    ipv4_address(
+        std::uint32_t u) noexcept
+    {
+        addr_[0] = static_cast<
+            unsigned char>(u >> 24);
+        addr_[1] = static_cast<
+            unsigned char>(u >> 16);
+        addr_[2] = static_cast<
+            unsigned char>(u >> 8);
+        addr_[3] = static_cast<
+            unsigned char>(u);
+    }
+
+    /** Return the address as bytes, in network byte order.
+    */
+    bytes_type
+    to_bytes() const noexcept
+    {
+        return addr_;
+    }
+
+    /** Return the address as an unsigned integer in host byte order.
+    */
+    std::uint32_t
+    to_uint() const noexcept
+    {
+        return
+            (static_cast<std::uint32_t>(addr_[0]) << 24) |
+            (static_cast<std::uint32_t>(addr_[1]) << 16) |
+            (static_cast<std::uint32_t>(addr_[2]) <<  8) |
+             static_cast<std::uint32_t>(addr_[3]);
+    }
+
+    /** Format the address in dotted decimal form.
+
+        The formatted string is written to the
+        caller-provided buffer, and no memory is
+        allocated. A buffer of @ref max_str_len
+        characters is always sufficient.
+
+        @par Exception Safety
+
+        Throws @ref too_large if the
+        buffer is not large enough.
+
+        @return A view of the formatted
+        string within `dest`.
+
+        @param dest The buffer to write to.
+
+        @param size The size of the buffer.
+    */
+    BOOST_URL_DECL
+    string_view
+    to_buffer(
+        char* dest,
+        std::size_t size) const;
+
+    /** Return true if two addresses are equal.
+    */
+    friend
+    bool
+    operator==(
+        ipv4_address const& a1,
+        ipv4_address const& a2) noexcept
+    {
+        return a1.addr_ == a2.addr_;
+    }
+
+    /** Return true if two addresses are not equal.
+    */
+    friend
+    bool
+    operator!=(
+        ipv4_address const& a1,
+        ipv4_address const& a2) noexcept
+    {
+        return a1.addr_ != a2.addr_;
+    }
+
+private:
+    bytes_type addr_{};
+};
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/ipv4_address.ipp>
+#endif
+
+#endif
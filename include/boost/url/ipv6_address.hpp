@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IPV6_ADDRESS_HPP
+#define BOOST_URL_IPV6_ADDRESS_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/ipv4_address.hpp>
+#include <array>
+
+namespace boost {
+namespace urls {
+
+/** An IP version 6 address.
+
+    Objects of this type are returned by
+    @ref url_view::ipv6_address and
+    @ref url_base::ipv6_address, holding the
+    binary address recorded when the host
+    was parsed.
+
+    @par Example
+    @code
+    url_view u( "http://[2001:DB8:0:0::1]/" );
+    char buf[ ipv6_address::max_str_len ];
+    assert( u.ipv6_address().to_buffer(
+        buf, sizeof(buf) ) == "2001:db8::1" );
+    @endcode
+*/
+class ipv6_address
+{
+public:
+    /** The type used to represent an address as an array of bytes.
+    */
+    using bytes_type =
+        std::array<unsigned char, 16>;
+
+    /** The largest number of characters in a formatted address.
+    */
+    static constexpr
+        std::size_t max_str_len = 45;
+
+    /** Constructor.
+
+        Default constructed objects
+        hold the unspecified address `::`.
+    */
+    ipv6_address() = default;
+
+    /** Constructor.
+
+        @param bytes The address in
+        network byte order.
+    */
+    explicit
+    ipv6_address(
+        bytes_type const& bytes) noexcept
+        : addr_(bytes)
+    {
+    }
+
+    /** Return the address as bytes, in network byte order.
+    */
+    bytes_type
+    to_bytes() const noexcept
+    {
+        return addr_;
+    }
+
+    /** Return true if this is an IPv4-mapped address.
+
+        IPv4-mapped addresses have the form
+        `::ffff:a.b.c.d`.
+    */
+    BOOST_URL_DECL
+    bool
+    is_v4_mapped() const noexcept;
+
+    /** Format the address in canonical form.
+
+        The address is written in the text
+        representation recommended by rfc5952:
+        hexadecimal digits are lowercase, leading
+        zeros in each group are omitted, and the
+        longest run of two or more zero groups is
+        replaced by "::". IPv4-mapped addresses
+        end in dotted decimal form.
+
+        The formatted string is written to the
+        caller-provided buffer, and no memory is
+        allocated. A buffer of @ref max_str_len
+        characters is always sufficient.
+
+        @par Exception Safety
+
+        Throws @ref too_large if the
+        buffer is not large enough.
+
+        @return A view of the formatted
+        string within `dest`.
+
+        @param dest The buffer to write to.
+
+        @param size The size of the buffer.
+
+        @par Specification
+        @li <a href="https://tools.ietf.org/html/rfc5952#section-4"
+            >4. A Recommendation for IPv6 Text Representation (rfc5952)</a>
+    */
+    BOOST_URL_DECL
+    string_view
+    to_buffer(
+        char* dest,
+        std::size_t size) const;
+
+    /** Return true if two addresses are equal.
+    */
+    friend
+    bool
+    operator==(
+        ipv6_address const& a1,
+        ipv6_address const& a2) noexcept
+    {
+        return a1.addr_ == a2.addr_;
+    }
+
+    /** Return true if two addresses are not equal.
+    */
+    friend
+    bool
+    operator!=(
+        ipv6_address const& a1,
+        ipv6_address const& a2) noexcept
+    {
+        return a1.addr_ != a2.addr_;
+    }
+
+private:
+    bytes_type addr_{};
+};
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/ipv6_address.ipp>
+#endif
+
+#endif
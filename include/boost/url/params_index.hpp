@@ -0,0 +1,264 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_PARAMS_INDEX_HPP
+#define BOOST_URL_PARAMS_INDEX_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/detail/char_type.hpp>
+#include <boost/url/detail/error_value.hpp>
+#include <boost/url/detail/parts.hpp>
+
+namespace boost {
+namespace urls {
+
+class url_view;
+class url_base;
+
+/** A hash index of the query parameters in a URL.
+
+    An index records the location of every query
+    parameter in an open addressing hash table
+    keyed by the decoded key, giving constant-time
+    `find` and `count`. It is filled by calling
+    `params` on a @ref url_view or @ref url_base,
+    and the returned container refers to the index.
+
+    The storage for the index is provided by the
+    caller, and no memory is allocated. An index
+    for up to `n` parameters needs room for
+    `storage_size(n)` integers.
+
+    @par Example
+    @code
+    static_params_index<64> idx;
+    url_view u( "/search?q=url&lang=en&page=2" );
+    auto const params = u.params( idx );
+    assert( params.find( "lang" )->encoded_value() == "en" );
+    @endcode
+
+    @see static_params_index
+*/
+class basic_params_index
+{
+    // per parameter: offset of the
+    // leading '?' or '&' shifted left
+    // two bits, key size, value size,
+    // key hash. The low bits are set for
+    // escapes in the key (1) or value (2).
+    static constexpr std::size_t stride = 4;
+
+    std::size_t* const e_;
+    std::size_t* const t_;
+    std::size_t const capacity_;
+    std::size_t const mask_;
+    std::size_t n_ = 0;
+
+    friend class url_view;
+    friend class url_base;
+
+    static
+    constexpr
+    std::size_t
+    table_size(
+        std::size_t n,
+        std::size_t t = 1) noexcept
+    {
+        // at most half full
+        return t >= 2 * n ? t :
+            table_size(n, 2 * t);
+    }
+
+    void
+    insert(
+        std::size_t off,
+        std::size_t nk,
+        std::size_t nv,
+        std::size_t pct,
+        char const* s) noexcept
+    {
+        auto const h =
+            detail::encoded_key_hash(
+                string_view(
+                    s + off + 1, nk - 1));
+        auto const e = e_ + stride * n_;
+        e[0] = (off << 2) | pct;
+        e[1] = nk;
+        e[2] = nv;
+        e[3] = h;
+        auto i = h & mask_;
+        while(t_[i] != 0)
+            i = (i + 1) & mask_;
+        // 0 means empty
+        t_[i] = ++n_;
+    }
+
+    // Record the parameters of the
+    // query in `s`, described by `pt`
+    void
+    build(
+        char const* s,
+        detail::parts const& pt)
+    {
+        if(pt.nparam > capacity_)
+            too_large::raise();
+        n_ = 0;
+        for(std::size_t i = 0;
+            i <= mask_; ++i)
+            t_[i] = 0;
+        if(pt.length(detail::id_query) == 0)
+            return;
+        auto const ek =
+            detail::qkey_pct_set();
+        auto const ev =
+            detail::qval_pct_set();
+        auto p = s + pt.offset[
+            detail::id_query];
+        auto const end = s + pt.offset[
+            detail::id_frag];
+        while(
+            p < end &&
+            n_ < pt.nparam)
+        {
+            // *p is '?' or '&'
+            auto const p0 = p;
+            detail::error_value ec;
+            bool pk = false;
+            p = ek.parse(p + 1, end, ec, pk);
+            BOOST_ASSERT(! ec);
+            auto const nk = static_cast<
+                std::size_t>(p - p0);
+            std::size_t nv = 0;
+            bool pv = false;
+            if( p < end &&
+                *p == '=')
+            {
+                auto const p1 = p;
+                p = ev.parse(p + 1, end, ec, pv);
+                BOOST_ASSERT(! ec);
+                nv = p - p1;
+            }
+            insert(p0 - s, nk, nv,
+                pk + 2 * pv, s);
+        }
+        BOOST_ASSERT(n_ == pt.nparam);
+    }
+
+    // Return the entry following
+    // `*i` in the probe sequence
+    // with a matching key, or null
+    std::size_t const*
+    find(
+        std::size_t& i,
+        std::size_t h,
+        string_view key,
+        char const* s) const noexcept
+    {
+        while(t_[i] != 0)
+        {
+            auto const e =
+                e_ + stride * (t_[i] - 1);
+            i = (i + 1) & mask_;
+            if( e[3] == h &&
+                detail::key_equal(
+                    string_view(
+                        s + (e[0] >> 2) + 1,
+                        e[1] - 1),
+                    key))
+                return e;
+        }
+        return nullptr;
+    }
+
+public:
+    basic_params_index(
+        basic_params_index const&) = delete;
+    basic_params_index& operator=(
+        basic_params_index const&) = delete;
+
+    /** Return the number of integers needed to index `n` parameters.
+    */
+    static
+    constexpr
+    std::size_t
+    storage_size(std::size_t n) noexcept
+    {
+        return stride * n + table_size(n);
+    }
+
+    /** Constructor.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @param data Storage for at least
+        `storage_size(capacity)` integers, which
+        must remain valid for the lifetime of the
+        index.
+
+        @param capacity The largest number of
+        parameters which may be indexed.
+    */
+    basic_params_index(
+        std::size_t* data,
+        std::size_t capacity) noexcept
+        : e_(data)
+        , t_(data + stride * capacity)
+        , capacity_(capacity)
+        , mask_(table_size(capacity) - 1)
+    {
+        for(std::size_t i = 0;
+            i <= mask_; ++i)
+            t_[i] = 0;
+    }
+
+    /** Return the largest number of parameters which may be indexed.
+    */
+    std::size_t
+    capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    /** Return the number of parameters in the last indexed query.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return n_;
+    }
+};
+
+/** A hash index of the query parameters with inline storage.
+
+    @tparam N The largest number of parameters
+    which may be indexed.
+
+    @see basic_params_index
+*/
+template<std::size_t N>
+class static_params_index
+    : public basic_params_index
+{
+    std::size_t buf_[
+        basic_params_index::storage_size(N)];
+
+public:
+    static_params_index() noexcept
+        : basic_params_index(buf_, N)
+    {
+    }
+};
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,230 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_PARSE_HPP
+#define BOOST_URL_PARSE_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/result.hpp>
+#include <boost/url/url_view.hpp>
+
+namespace boost {
+namespace urls {
+
+/** Parse a <em>URI</em>.
+
+    The string must contain a scheme. No exceptions
+    are thrown for invalid input; instead the result
+    holds the error, and the offset in `s` of the
+    character where it was detected.
+
+    @par ABNF
+    @code
+    URI           = scheme ":" hier-part [ "?" query ] [ "#" fragment ]
+    @endcode
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param s The string to parse. The returned
+    view references this string.
+*/
+BOOST_URL_DECL
+result<url_view>
+parse_uri(string_view s) noexcept;
+
+/** Parse a <em>relative-ref</em>.
+
+    The string must not contain a scheme. No
+    exceptions are thrown for invalid input;
+    instead the result holds the error, and the
+    offset in `s` of the character where it was
+    detected.
+
+    @par ABNF
+    @code
+    relative-ref  = relative-part [ "?" query ] [ "#" fragment ]
+    @endcode
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param s The string to parse. The returned
+    view references this string.
+*/
+BOOST_URL_DECL
+result<url_view>
+parse_relative_ref(string_view s) noexcept;
+
+/** Parse a <em>URI-reference</em>.
+
+    This accepts the same strings as the
+    @ref url_view constructor, without throwing.
+    On failure the result holds the error, and
+    the offset in `s` of the character where it
+    was detected.
+
+    @par ABNF
+    @code
+    URI-reference = URI / relative-ref
+    @endcode
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param s The string to parse. The returned
+    view references this string.
+*/
+BOOST_URL_DECL
+result<url_view>
+parse_uri_reference(string_view s) noexcept;
+
+//----------------------------------------------------------
+//
+// HTTP request-target
+//
+//----------------------------------------------------------
+
+/** Parse an HTTP request-target in <em>origin-form</em>.
+
+    This is the form used by most requests sent
+    directly to an origin server, as in
+    `GET /where?q=now HTTP/1.1`. Only a path and
+    query are accepted, so no attempt is made to
+    match a scheme or an authority. A path which
+    starts with "//" is rejected, since it would
+    be read as an authority once the URL is
+    serialized. No exceptions
+    are thrown for invalid input; instead the result
+    holds the error, and the offset in `s` of the
+    character where it was detected.
+
+    @par ABNF
+    @code
+    origin-form   = absolute-path [ "?" query ]
+
+    absolute-path = 1*( "/" segment )
+    @endcode
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param s The string to parse. The returned
+    view references this string.
+
+    @see https://tools.ietf.org/html/rfc7230#section-5.3.1
+*/
+BOOST_URL_DECL
+result<url_view>
+parse_origin_form(string_view s) noexcept;
+
+/** Parse an HTTP request-target in <em>absolute-form</em>.
+
+    This is the form used by requests sent to a
+    proxy, as in
+    `GET http://www.example.org/pub/WWW/ HTTP/1.1`.
+    A fragment is not allowed. No exceptions are
+    thrown for invalid input; instead the result
+    holds the error, and the offset in `s` of the
+    character where it was detected.
+
+    @par ABNF
+    @code
+    absolute-form = absolute-URI
+
+    absolute-URI  = scheme ":" hier-part [ "?" query ]
+    @endcode
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param s The string to parse. The returned
+    view references this string.
+
+    @see https://tools.ietf.org/html/rfc7230#section-5.3.2
+*/
+BOOST_URL_DECL
+result<url_view>
+parse_absolute_form(string_view s) noexcept;
+
+/** Parse an HTTP request-target in <em>authority-form</em>.
+
+    This is the form used only by CONNECT requests,
+    as in `CONNECT www.example.com:80 HTTP/1.1`.
+    A userinfo is not allowed and the port is
+    required. The string has no leading "//",
+    but @ref url_view::has_authority returns `true`
+    and @ref url_view::encoded_authority returns
+    the entire string. Since @ref url_view::encoded_url
+    is then not a URL with the same parts, copying
+    the view into a @ref url, or resolving it as a
+    reference, adds the "//". No exceptions are thrown for
+    invalid input; instead the result holds the
+    error, and the offset in `s` of the character
+    where it was detected.
+
+    @par ABNF
+    @code
+    authority-form = uri-host ":" port
+    @endcode
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param s The string to parse. The returned
+    view references this string.
+
+    @see https://tools.ietf.org/html/rfc7230#section-5.3.3
+*/
+BOOST_URL_DECL
+result<url_view>
+parse_authority_form(string_view s) noexcept;
+
+/** Parse an HTTP request-target in <em>asterisk-form</em>.
+
+    This is the form used only by server-wide
+    OPTIONS requests, as in
+    `OPTIONS * HTTP/1.1`. The returned view has
+    a path of "*" with one segment. No exceptions
+    are thrown for invalid input; instead the result
+    holds the error, and the offset in `s` of the
+    character where it was detected.
+
+    @par ABNF
+    @code
+    asterisk-form = "*"
+    @endcode
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param s The string to parse. The returned
+    view references this string.
+
+    @see https://tools.ietf.org/html/rfc7230#section-5.3.4
+*/
+BOOST_URL_DECL
+result<url_view>
+parse_asterisk_form(string_view s) noexcept;
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/parse.ipp>
+#endif
+
+#endif
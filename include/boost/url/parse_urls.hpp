@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_PARSE_URLS_HPP
+#define BOOST_URL_PARSE_URLS_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/host_type.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+/** Column arrays written by @ref parse_urls.
+
+    Each member points to an array supplied by
+    the caller, with one element for every URL
+    in the batch. Null members are skipped, so
+    a pass that only needs hosts pays only for
+    the host columns.
+
+    The offset columns hold the position in the
+    input string where each part begins, using
+    the same boundaries as @ref url_view. Part
+    `i` of a URL is the range from its own
+    column to the next one:
+
+    @li scheme: `[0, user)`, including the
+        trailing colon
+
+    @li user: `[user, password)`, including the
+        leading double slash when an authority
+        is present
+
+    @li password: `[password, host)`, including
+        the leading colon and trailing at sign
+
+    @li host: `[host, port)`
+
+    @li port: `[port, path)`, including the
+        leading colon
+
+    @li path: `[path, query)`
+
+    @li query: `[query, fragment)`, including
+        the leading question mark
+
+    @li fragment: `[fragment, end)`, including
+        the leading number sign
+
+    When a URL fails to parse, every offset and
+    count in its row is set to zero.
+*/
+struct url_columns
+{
+    std::size_t* user = nullptr;
+    std::size_t* password = nullptr;
+    std::size_t* host = nullptr;
+    std::size_t* port = nullptr;
+    std::size_t* path = nullptr;
+    std::size_t* query = nullptr;
+    std::size_t* fragment = nullptr;
+    std::size_t* end = nullptr;
+
+    /// The number of path segments
+    std::size_t* segments = nullptr;
+
+    /// The number of query parameters
+    std::size_t* params = nullptr;
+
+    /// The type of host
+    urls::host_type* host_type = nullptr;
+
+    /// The result of parsing each URL
+    error_code* ec = nullptr;
+};
+
+/** Parse a batch of URLs into columns.
+
+    Each string is parsed as a URI-reference,
+    exactly as the @ref url_view constructor
+    would, and the location of its parts is
+    written to row `i` of every non-null column
+    in `out`. No exceptions are thrown for
+    invalid input; the error is stored in
+    `out.ec` when that column is present.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @return The number of strings which were
+    parsed successfully.
+
+    @param urls A pointer to an array of `n`
+    strings to parse.
+
+    @param n The number of strings.
+
+    @param out The columns to fill in.
+*/
+BOOST_URL_DECL
+std::size_t
+parse_urls(
+    string_view const* urls,
+    std::size_t n,
+    url_columns const& out) noexcept;
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/parse_urls.ipp>
+#endif
+
+#endif
@@ -0,0 +1,101 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_RESOLVE_HPP
+#define BOOST_URL_RESOLVE_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/url_base.hpp>
+#include <boost/url/url_view.hpp>
+
+namespace boost {
+namespace urls {
+
+/** Resolve a URL reference against a base URL.
+
+    This function computes the target URL of the
+    reference `ref` in the context of `base`, as
+    described in rfc3986 section 5.2, and assigns
+    it to `dest`. Dot segments are removed from
+    the path of the result.
+
+    The length of the result is computed first,
+    then each component is written once, directly
+    from the parsed parts of `base` and `ref`.
+    Nothing is parsed again, and the storage of
+    `dest` is resized at most once, so a
+    @ref static_url may be used to resolve
+    without allocating.
+
+    @par Example
+    @code
+    url u;
+    resolve(
+        url_view( "http://a/b/c/d;p?q" ),
+        url_view( "../g?y#s" ), u );
+    assert( u.encoded_url() == "http://a/b/g?y#s" );
+    @endcode
+
+    @par Precondition
+    `dest` does not hold the string referenced
+    by `base` or `ref`.
+
+    @par Exception Safety
+    Strong guarantee.
+    Calls to allocate may throw.
+
+    @param base The base URL, which
+    must have a scheme.
+
+    @param ref The reference to resolve.
+
+    @param dest The container to hold
+    the result.
+
+    @param ec Set to the error, if any occurred.
+    If `base` has no scheme, the error is
+    @ref error::missing_scheme and `dest`
+    is unchanged.
+
+    @see @li <a href="https://tools.ietf.org/html/rfc3986#section-5.2">5.2. Relative Resolution (rfc3986)</a>
+*/
+BOOST_URL_DECL
+void
+resolve(
+    url_view const& base,
+    url_view const& ref,
+    url_base& dest,
+    error_code& ec);
+
+/** Resolve a URL reference against a base URL.
+
+    @par Exception Safety
+    Strong guarantee.
+    Calls to allocate may throw.
+
+    @throw invalid_part `base` has no scheme.
+
+    @see resolve
+*/
+BOOST_URL_DECL
+void
+resolve(
+    url_view const& base,
+    url_view const& ref,
+    url_base& dest);
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/resolve.ipp>
+#endif
+
+#endif
@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_RESULT_HPP
+#define BOOST_URL_RESULT_HPP
+
+#include <boost/url/config.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+/** The result of a parsing function which does not throw.
+
+    Objects of this type hold either a value, or the
+    error which prevented the value from being
+    produced, together with the offset in the input
+    where parsing stopped. On success the offset is
+    the size of the input.
+
+    @par Example
+    @code
+    result<url_view> r = parse_uri( s );
+    if(! r )
+        log( r.error().message(), r.position() );
+    else
+        route( r->encoded_path() );
+    @endcode
+
+    @tparam T The type of value held.
+*/
+template<class T>
+class result
+{
+    T v_;
+    error_code ec_;
+    std::size_t pos_ = 0;
+
+public:
+    /// The type of value held
+    using value_type = T;
+
+    /** Constructor.
+
+        Default-constructed results hold a
+        default-constructed value.
+    */
+    result() = default;
+
+    /** Constructor.
+
+        The result holds the specified value.
+    */
+    result(
+        T const& v,
+        std::size_t pos)
+        : v_(v)
+        , pos_(pos)
+    {
+    }
+
+    /** Constructor.
+
+        The result holds the specified error.
+    */
+    result(
+        error_code const& ec,
+        std::size_t pos) noexcept
+        : ec_(ec)
+        , pos_(pos)
+    {
+    }
+
+    /** Return true if the result holds a value.
+    */
+    bool
+    has_value() const noexcept
+    {
+        return ! ec_;
+    }
+
+    /** Return true if the result holds an error.
+    */
+    bool
+    has_error() const noexcept
+    {
+        return !! ec_;
+    }
+
+    /** Return true if the result holds a value.
+    */
+    explicit
+    operator bool() const noexcept
+    {
+        return ! ec_;
+    }
+
+    /** Return the value.
+
+        @throws system_error The result
+        holds an error.
+    */
+    T const&
+    value() const
+    {
+        if(ec_)
+            BOOST_THROW_EXCEPTION(
+                system_error(ec_));
+        return v_;
+    }
+
+    /** Return the value.
+
+        @par Preconditions
+        @code
+        this->has_value()
+        @endcode
+    */
+    T const&
+    operator*() const noexcept
+    {
+        BOOST_ASSERT(! ec_);
+        return v_;
+    }
+
+    /** Return a pointer to the value.
+
+        @par Preconditions
+        @code
+        this->has_value()
+        @endcode
+    */
+    T const*
+    operator->() const noexcept
+    {
+        BOOST_ASSERT(! ec_);
+        return &v_;
+    }
+
+    /** Return the error, if any.
+    */
+    error_code
+    error() const noexcept
+    {
+        return ec_;
+    }
+
+    /** Return the offset where parsing stopped.
+
+        If the result holds an error, this is the
+        offset of the character in the input where
+        the error was detected. Otherwise, this is
+        the number of characters consumed.
+    */
+    std::size_t
+    position() const noexcept
+    {
+        return pos_;
+    }
+};
+
+} // urls
+} // boost
+
+#endif
@@ -11,6 +11,7 @@
 #define BOOST_URL_SCHEME_HPP
 
 #include <boost/url/config.hpp>
+#include <cstdint>
 
 namespace boost {
 namespace urls {
@@ -29,6 +30,65 @@ enum class scheme : unsigned char
     wss
 };
 
+namespace detail {
+
+// ASCII letters compare
+// without regard to case
+BOOST_URL_CONSTEXPR
+inline
+bool
+scheme_eq(
+    string_view s,
+    char const* lit) noexcept
+{
+    for(std::size_t i = 0;
+        i < s.size(); ++i)
+    {
+        auto c = s[i];
+        if(c >= 'A' && c <= 'Z')
+            c += 'a' - 'A';
+        if(c != lit[i])
+            return false;
+    }
+    return true;
+}
+
+BOOST_URL_CONSTEXPR
+inline
+scheme
+get_scheme(
+    string_view s) noexcept
+{
+    switch(s.size())
+    {
+    case 2:
+        if(scheme_eq(s, "ws"))
+            return scheme::ws;
+        break;
+    case 3:
+        if(scheme_eq(s, "wss"))
+            return scheme::wss;
+        if(scheme_eq(s, "ftp"))
+            return scheme::ftp;
+        break;
+    case 4:
+        if(scheme_eq(s, "http"))
+            return scheme::http;
+        if(scheme_eq(s, "file"))
+            return scheme::file;
+        break;
+    case 5:
+        if(scheme_eq(s, "https"))
+            return scheme::https;
+        break;
+    default:
+        break;
+    }
+    return scheme::unknown;
+}
+
+} // detail
+
 /** Return the scheme for a non-normalized string, if known
 */
 BOOST_URL_DECL
@@ -41,6 +101,19 @@ BOOST_URL_DECL
 string_view
 to_string(scheme s) noexcept;
 
+/** Return the default port for a known scheme.
+
+    The default ports are those registered for
+    each of the special schemes: 21 for ftp, 80
+    for http and ws, and 443 for https and wss.
+
+    @return The port number, or zero if the
+    scheme has no default port.
+*/
+BOOST_URL_DECL
+std::uint16_t
+default_port(scheme s) noexcept;
+
 /** Return `true` if the scheme string is a special scheme.
 
     The list of special schemes is as follows:
@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_SEGMENTS_INDEX_HPP
+#define BOOST_URL_SEGMENTS_INDEX_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/detail/parts.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+class url_view;
+class url_base;
+
+/** An index of the path segments in a URL.
+
+    An index records the offset of every path
+    segment and whether it contains escapes,
+    giving constant-time random access to the
+    segments of a path. It is filled by
+    calling `segments` on a @ref url_view or
+    @ref url_base, and the returned container
+    refers to the index.
+
+    The storage for the index is provided by the
+    caller, and no memory is allocated. A path
+    with `n` segments needs room for `n + 1`
+    offsets.
+
+    @par Example
+    @code
+    static_segments_index<16> idx;
+    url_view u( "/path/to/file.txt" );
+    auto const segs = u.segments( idx );
+    assert( segs[2].encoded_string() == "file.txt" );
+    @endcode
+
+    @see static_segments_index
+*/
+class basic_segments_index
+{
+    std::size_t* const v_;
+    std::size_t const capacity_;
+    std::size_t n_ = 0;
+
+    friend class url_view;
+    friend class url_base;
+
+    // Record the segments of the
+    // path in `s`, described by `pt`
+    void
+    build(
+        char const* s,
+        detail::parts const& pt)
+    {
+        if(pt.nseg > capacity_)
+            too_large::raise();
+        n_ = 0;
+        if(pt.nseg == 0)
+            return;
+        auto const p0 = s + pt.offset[
+            detail::id_path];
+        auto const end = s + pt.offset[
+            detail::id_query];
+        // the first segment starts the path,
+        // after that each '/' starts one
+        v_[n_++] = pt.offset[
+            detail::id_path];
+        auto p = p0 + 1;
+        while(
+            p < end &&
+            n_ < pt.nseg)
+        {
+            auto const q = static_cast<
+                char const*>(std::memchr(
+                    p, '/', end - p));
+            if(! q)
+                break;
+            v_[n_++] = q - s;
+            p = q + 1;
+        }
+        BOOST_ASSERT(n_ == pt.nseg);
+        v_[n_] = pt.offset[
+            detail::id_query];
+
+        // the low bit of each entry is
+        // set when the segment has escapes
+        for(std::size_t i = 0;
+            i <= n_; ++i)
+            v_[i] <<= 1;
+        if(! pt.has_pct(detail::id_path))
+            return;
+        std::size_t i = 0;
+        p = p0;
+        while(p < end)
+        {
+            auto const q = static_cast<
+                char const*>(std::memchr(
+                    p, '%', end - p));
+            if(! q)
+                break;
+            auto const off = static_cast<
+                std::size_t>(q - s);
+            while((v_[i + 1] >> 1) <= off)
+                ++i;
+            v_[i] |= 1;
+            // on to the next segment
+            p = s + (v_[i + 1] >> 1);
+        }
+    }
+
+public:
+    basic_segments_index(
+        basic_segments_index const&) = delete;
+    basic_segments_index& operator=(
+        basic_segments_index const&) = delete;
+
+    /** Constructor.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @param data Storage for at least
+        `capacity + 1` offsets, which must remain
+        valid for the lifetime of the index.
+
+        @param capacity The largest number of
+        segments which may be indexed.
+    */
+    basic_segments_index(
+        std::size_t* data,
+        std::size_t capacity) noexcept
+        : v_(data)
+        , capacity_(capacity)
+    {
+    }
+
+    /** Return the largest number of segments which may be indexed.
+    */
+    std::size_t
+    capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    /** Return the number of segments in the last indexed path.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return n_;
+    }
+};
+
+/** An index of the path segments with inline storage.
+
+    @tparam N The largest number of segments
+    which may be indexed.
+
+    @see basic_segments_index
+*/
+template<std::size_t N>
+class static_segments_index
+    : public basic_segments_index
+{
+    std::size_t buf_[N + 1];
+
+public:
+    static_segments_index() noexcept
+        : basic_segments_index(buf_, N)
+    {
+    }
+};
+
+} // urls
+} // boost
+
+#endif
@@ -24,8 +24,17 @@ in a translation unit of the program.
 #endif
 
 #include <boost/url/impl/url_base.ipp>
+#include <boost/url/impl/decode.ipp>
+#include <boost/url/impl/decoded_view.ipp>
+#include <boost/url/impl/equivalent.ipp>
 #include <boost/url/impl/error.ipp>
+#include <boost/url/impl/ipv4_address.ipp>
+#include <boost/url/impl/ipv6_address.ipp>
+#include <boost/url/impl/parse.ipp>
+#include <boost/url/impl/parse_urls.ipp>
+#include <boost/url/impl/resolve.ipp>
 #include <boost/url/impl/scheme.ipp>
+#include <boost/url/impl/url_parser.ipp>
 #include <boost/url/impl/url_view.ipp>
 
 #endif
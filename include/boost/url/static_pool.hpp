@@ -11,51 +11,214 @@
 #define BOOST_URL_STATIC_POOL_HPP
 
 #include <boost/url/config.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <functional>
+#include <new>
 
 namespace boost {
 namespace urls {
 
 class basic_static_pool
 {
+public:
+    class upstream;
+
+    /** Counters describing the use of a pool.
+
+        These may be used to choose the size
+        of a pool from real traffic.
+    */
+    struct statistics
+    {
+        /// Allocations served from the pool
+        std::size_t allocations = 0;
+
+        /// Allocations passed to the upstream
+        std::size_t overflows = 0;
+
+        /// Bytes of the pool now in use
+        std::size_t used = 0;
+
+        /// The largest number of bytes of the pool in use at once
+        std::size_t high_water = 0;
+    };
+
+private:
     char* const base_;
     std::size_t const capacity_;
     char* top_;
+    // blocks below the most recent
+    // mark are neither freed nor grown
+    char* floor_;
+    upstream* up_ = nullptr;
+    statistics st_;
 
     template<class T>
     friend class allocator_type;
 
+    bool
+    owns(char const* p) const noexcept
+    {
+        return
+            std::less_equal<char const*>()(
+                base_, p) &&
+            std::less<char const*>()(
+                p, base_ + capacity_);
+    }
+
+    void
+    set_top(char* top) noexcept
+    {
+        top_ = top;
+        std::size_t const n = top_ - base_;
+        if(st_.high_water < n)
+            st_.high_water = n;
+    }
+
+    inline
     void*
     allocate(
         std::size_t bytes,
-        std::size_t align)
-    {
-        auto const u0 = std::uintptr_t(top_);
-        auto const u = align * (
-            (u0 + align - 1) / align);
-        auto const p =
-            reinterpret_cast<char*>(u);
-        if( u < u0 || bytes >
-            capacity_ - (p - base_))
-            BOOST_THROW_EXCEPTION(
-                std::bad_alloc());
-        top_ = reinterpret_cast<
-            char*>(p + bytes);
-        return p;
-    }
+        std::size_t align);
 
+    inline
     void
     deallocate(
         void* p,
         std::size_t bytes,
-        std::size_t align) noexcept
+        std::size_t align) noexcept;
+
+    // Grows the most recent block
+    // in place, if there is room
+    bool
+    extend(
+        void* p,
+        std::size_t bytes,
+        std::size_t new_bytes) noexcept
     {
-        (void)p;
-        (void)bytes;
-        (void)align;
+        auto const p0 =
+            static_cast<char*>(p);
+        if( ! owns(p0) ||
+            p0 < floor_ ||
+            p0 + bytes != top_ ||
+            new_bytes < bytes ||
+            new_bytes - bytes >
+                capacity_ - (top_ - base_))
+            return false;
+        set_top(p0 + new_bytes);
+        return true;
     }
 
 public:
+    /** The memory used by a pool once it runs out.
+
+        When a pool has an upstream, allocations
+        which do not fit in the pool are passed to
+        it instead of throwing, and given back to
+        it when they are deallocated.
+
+        @see new_delete_upstream
+    */
+    class upstream
+    {
+    public:
+        virtual ~upstream() = default;
+
+        /** Allocate memory.
+
+            @throw std::bad_alloc The memory
+            could not be allocated.
+        */
+        virtual
+        void*
+        allocate(
+            std::size_t bytes,
+            std::size_t align) = 0;
+
+        /** Deallocate memory returned by @ref allocate.
+        */
+        virtual
+        void
+        deallocate(
+            void* p,
+            std::size_t bytes,
+            std::size_t align) noexcept = 0;
+    };
+
+    /** Return an upstream which uses global operator new.
+
+        Alignments larger than that of
+        `std::max_align_t` are not supported.
+    */
+    static
+    inline
+    upstream&
+    new_delete_upstream() noexcept;
+
+    /** A position in the pool, returned by @ref mark.
+    */
+    class marker
+    {
+        char* top_;
+        char* floor_;
+
+        friend class basic_static_pool;
+
+        marker(
+            char* top,
+            char* floor) noexcept
+            : top_(top)
+            , floor_(floor)
+        {
+        }
+    };
+
+    /** Rewinds a pool when it goes out of scope.
+
+        Everything allocated from the pool
+        during the lifetime of the scope is
+        freed at once when it is destroyed.
+        Objects using that memory must be
+        destroyed first, and objects which
+        outlive the scope must not grow
+        during it.
+
+        @par Example
+        @code
+        static_pool< 4096 > sp;
+        for(;;)
+        {
+            basic_static_pool::scope s( sp );
+            basic_url< basic_static_pool::allocator_type< char > > u( sp.allocator() );
+            // ...
+        }
+        @endcode
+    */
+    class scope
+    {
+        basic_static_pool& pool_;
+        marker m_;
+
+    public:
+        scope(scope const&) = delete;
+        scope& operator=(scope const&) = delete;
+
+        explicit
+        scope(
+            basic_static_pool& pool) noexcept
+            : pool_(pool)
+            , m_(pool.mark())
+        {
+        }
+
+        ~scope()
+        {
+            pool_.rewind(m_);
+        }
+    };
+
     template<class T>
     class allocator_type
     {
@@ -119,6 +282,27 @@ public:
                 alignof(T));
         }
 
+        /** Grow an allocation in place.
+
+            This succeeds only for the most recent
+            allocation of the pool, when there is
+            room after it. Otherwise, nothing is
+            changed.
+
+            @return `true` if the `n` objects at `p`
+            now extend to `new_n` objects.
+        */
+        bool
+        try_extend(
+            pointer p,
+            size_type n,
+            size_type new_n) noexcept
+        {
+            return pool_->extend(p,
+                n * sizeof(T),
+                new_n * sizeof(T));
+        }
+
         template<class U>
         bool
         operator==(allocator_type<U> const& other) const noexcept
@@ -134,12 +318,36 @@ public:
         }
     };
 
+    /** Constructor.
+
+        When the pool runs out, allocations
+        throw `std::bad_alloc`.
+    */
     basic_static_pool(
         char* buffer,
         std::size_t size)
         : base_(buffer)
         , capacity_(size)
         , top_(buffer)
+        , floor_(buffer)
+    {
+    }
+
+    /** Constructor.
+
+        When the pool runs out, memory is
+        allocated from `up` instead. The
+        upstream must outlive the pool.
+    */
+    basic_static_pool(
+        char* buffer,
+        std::size_t size,
+        upstream& up)
+        : base_(buffer)
+        , capacity_(size)
+        , top_(buffer)
+        , floor_(buffer)
+        , up_(&up)
     {
     }
 
@@ -148,8 +356,168 @@ public:
     {
         return allocator_type<char>(*this);
     }
+
+    /** Return the size of the pool in bytes.
+    */
+    std::size_t
+    capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    /** Return the number of bytes in use.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return top_ - base_;
+    }
+
+    /** Return the usage counters of the pool.
+    */
+    statistics
+    stats() const noexcept
+    {
+        auto st = st_;
+        st.used = size();
+        return st;
+    }
+
+    /** Set the usage counters of the pool to zero.
+
+        The high-water mark starts again
+        from the bytes now in use.
+    */
+    void
+    reset_stats() noexcept
+    {
+        st_ = statistics();
+        st_.high_water = size();
+    }
+
+    /** Return the current position in the pool.
+
+        Until the marker is rewound, blocks
+        allocated before it are not given back
+        or grown in place, so that the rewind
+        frees only the blocks allocated after.
+
+        @see rewind
+    */
+    marker
+    mark() noexcept
+    {
+        marker const m(top_, floor_);
+        floor_ = top_;
+        return m;
+    }
+
+    /** Free everything allocated after a marker.
+
+        Objects using the memory allocated since
+        `m` was returned must be destroyed first.
+
+        @param m A marker returned by @ref mark
+        for this pool, not already rewound past.
+    */
+    void
+    rewind(marker m) noexcept
+    {
+        BOOST_ASSERT(
+            m.top_ >= base_ &&
+            m.top_ <= top_);
+        top_ = m.top_;
+        floor_ = m.floor_;
+    }
 };
 
+//----------------------------------------------------------
+
+void*
+basic_static_pool::
+allocate(
+    std::size_t bytes,
+    std::size_t align)
+{
+    auto const u0 = std::uintptr_t(top_);
+    auto const u = align * (
+        (u0 + align - 1) / align);
+    auto const p =
+        reinterpret_cast<char*>(u);
+    // the alignment may go past the end
+    if( u < u0 ||
+        static_cast<std::size_t>(
+            p - base_) > capacity_ ||
+        bytes > capacity_ - (p - base_))
+    {
+        if(! up_)
+            BOOST_THROW_EXCEPTION(
+                std::bad_alloc());
+        auto const r =
+            up_->allocate(bytes, align);
+        ++st_.overflows;
+        return r;
+    }
+    set_top(p + bytes);
+    ++st_.allocations;
+    return p;
+}
+
+// Only the most recent block, when it is
+// above the last mark, is given back.
+// Other blocks are kept until the pool
+// is rewound.
+void
+basic_static_pool::
+deallocate(
+    void* p,
+    std::size_t bytes,
+    std::size_t align) noexcept
+{
+    auto const p0 =
+        static_cast<char*>(p);
+    if(! owns(p0))
+    {
+        BOOST_ASSERT(up_);
+        up_->deallocate(p, bytes, align);
+        return;
+    }
+    if( p0 >= floor_ &&
+        p0 + bytes == top_)
+        top_ = p0;
+}
+
+auto
+basic_static_pool::
+new_delete_upstream() noexcept ->
+    upstream&
+{
+    struct impl : upstream
+    {
+        void*
+        allocate(
+            std::size_t bytes,
+            std::size_t align) override
+        {
+            BOOST_ASSERT(align <=
+                alignof(std::max_align_t));
+            (void)align;
+            return ::operator new(bytes);
+        }
+
+        void
+        deallocate(
+            void* p,
+            std::size_t,
+            std::size_t) noexcept override
+        {
+            ::operator delete(p);
+        }
+    };
+    static impl up;
+    return up;
+}
+
 template<std::size_t N>
 class static_pool : public basic_static_pool
 {
@@ -160,6 +528,12 @@ public:
         : basic_static_pool(buf_, N)
     {
     }
+
+    explicit
+    static_pool(upstream& up)
+        : basic_static_pool(buf_, N, up)
+    {
+    }
 };
 
 } // urls
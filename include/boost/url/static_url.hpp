@@ -12,39 +12,144 @@
 
 #include <boost/url/config.hpp>
 #include <boost/url/url_base.hpp>
-#include <cstdlib>
-#include <utility>
+#include <boost/url/detail/storage.hpp>
+#include <cstring>
 
 namespace boost {
 namespace urls {
 
+/** A URL with fixed capacity.
+
+    This container holds a URL of up to `N`
+    characters in a buffer inside the object,
+    and never allocates memory. Operations which
+    would make the URL longer than `N` throw
+    @ref too_large and leave it unchanged.
+
+    Copies are made by copying the characters
+    and the positions of the parts, so the URL
+    is not parsed again.
+
+    @par Example
+    @code
+    static_url<1024> u( "http://www.example.com" );
+    u.set_encoded_path( "/index.html" );
+    @endcode
+
+    @tparam N The largest number of characters,
+    not counting the null terminator.
+*/
 template<std::size_t N>
 class static_url
-    : public url_base
+    : private detail::fixed_storage_member<N>
+    , public url_base
 {
-    char buf_[N + 1];
+    template<std::size_t>
+    friend class static_url;
+
+    void
+    copy(url_base const& u)
+    {
+        auto const n = u.size();
+        auto const s =
+            this->st_.resize(n);
+        //---
+        if(n > 0)
+            std::memcpy(s, u.s_, n);
+        s_ = s;
+        pt_ = u.pt_;
+    }
 
 public:
-    template<class... Args>
+    /** Constructor.
+
+        Default constructed URLs are empty.
+    */
+    static_url() noexcept
+        : url_base(this->st_)
+    {
+    }
+
+    /** Constructor.
+
+        @param s The URL to parse.
+
+        @throw invalid_part `s` is not a valid URL.
+
+        @throw too_large `s` is longer than `N`.
+    */
+    explicit
+    static_url(
+        string_view s)
+        : url_base(this->st_, s)
+    {
+    }
+
+    /** Constructor.
+
+        The characters of the view are copied,
+        and the URL is not parsed again.
+
+        @param v The URL to copy.
+
+        @throw too_large The URL is
+        longer than `N`.
+    */
     explicit
-    static_url(Args&&... args)
-        : url_base(
-            std::forward<Args>(args)...)
+    static_url(
+        url_view const& v)
+        : url_base(this->st_)
+    {
+        assign(v);
+    }
+
+    /** Constructor.
+    */
+    static_url(
+        static_url const& u) noexcept
+        : url_base(this->st_)
     {
-        // VFALCO TODO
+        copy(u);
     }
 
+    /** Constructor.
+
+        @throw too_large The URL is
+        longer than `N`.
+    */
+    template<std::size_t M>
     static_url(
-        static_url const&) noexcept
+        static_url<M> const& u)
+        : url_base(this->st_)
     {
-        // VFALCO TODO
+        copy(u);
     }
 
+    /** Assignment.
+    */
+    static_url&
+    operator=(
+        static_url const& u) noexcept
+    {
+        if(this != &u)
+            copy(u);
+        return *this;
+    }
+
+    /** Assignment.
+
+        @par Exception Safety
+        Strong guarantee.
+
+        @throw too_large The URL is
+        longer than `N`.
+    */
+    template<std::size_t M>
     static_url&
     operator=(
-        static_url const&) noexcept
+        static_url<M> const& u)
     {
-        // VFALCO TODO
+        copy(u);
         return *this;
     }
 };
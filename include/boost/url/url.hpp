@@ -17,7 +17,14 @@
 namespace boost {
 namespace urls {
 
-using url = basic_url<std::allocator<char>>;
+/** A container for storing a URL.
+
+    Most URLs seen in practice are shorter than
+    128 characters, and are stored without
+    allocating.
+*/
+using url = basic_url<
+    std::allocator<char>, 128>;
 
 } // urls
 } // boost
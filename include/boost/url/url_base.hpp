@@ -11,6 +11,9 @@
 #define BOOST_URL_URL_BASE_HPP
 
 #include <boost/url/config.hpp>
+#include <boost/url/ipv4_address.hpp>
+#include <boost/url/ipv6_address.hpp>
+#include <boost/url/scheme.hpp>
 #include <boost/url/url_view.hpp>
 #include <boost/url/detail/char_type.hpp>
 #include <boost/url/detail/parts.hpp>
@@ -53,12 +56,20 @@ class url_base
     char* s_ = nullptr;
 
 private:
-    template<class Allocator>
+    template<class, std::size_t>
     friend class basic_url;
 
     template<std::size_t>
     friend class static_url;
 
+    friend BOOST_URL_DECL
+    void
+    resolve(
+        url_view const& base,
+        url_view const& ref,
+        url_base& dest,
+        error_code& ec);
+
     /** Construct an empty URL with the specified storage.
     */
     BOOST_URL_DECL
@@ -159,6 +170,28 @@ public:
     string_view
     encoded_origin() const noexcept;
 
+    /** Set the URL from a parsed view.
+
+        The characters of the view are copied,
+        and the positions of its parts are used
+        as they are, so the URL is not parsed
+        again. The storage is resized at most
+        once. A view of a request target in
+        authority-form, which has no leading
+        "//", gets one.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param v The URL to set. It may refer to
+        the characters of this URL.
+    */
+    BOOST_URL_DECL
+    url_base&
+    assign(url_view const& v);
+
     /** Set the URL.
 
         @par Exception Safety
@@ -177,6 +210,27 @@ public:
     set_encoded_url(
         string_view s);
 
+    /** Set the URL.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_url(
+        string_view s,
+        error_code& ec);
+
     /** Set the origin to the specified value.
 
         The origin consists of the everything from the
@@ -197,6 +251,27 @@ public:
     set_encoded_origin(
         string_view s);
 
+    /** Set the origin to the specified value.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_origin(
+        string_view s,
+        error_code& ec);
+
     //------------------------------------------------------
     //
     // scheme
@@ -217,6 +292,24 @@ public:
     string_view
     scheme() const noexcept;
 
+    /** Return the known scheme, if any.
+
+        The scheme is classified when the URL is
+        parsed, so no string comparison is made.
+        If the scheme is absent or is not one of
+        the special schemes, @ref scheme::unknown
+        is returned.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    urls::scheme
+    scheme_id() const noexcept
+    {
+        return pt_.scheme_id;
+    }
+
     /** Set the scheme.
 
         This function sets the scheme to the specified
@@ -250,6 +343,27 @@ public:
     url_base&
     set_scheme(string_view s);
 
+    /** Set the scheme.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_scheme(
+        string_view s,
+        error_code& ec);
+
     //------------------------------------------------------
     //
     // authority
@@ -303,6 +417,27 @@ public:
     set_encoded_authority(
         string_view s);
 
+    /** Set the authority.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_authority(
+        string_view s,
+        error_code& ec);
+
     //------------------------------------------------------
     //
     // userinfo
@@ -389,6 +524,27 @@ public:
     set_encoded_userinfo(
         string_view s);
 
+    /** Set the userinfo.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_userinfo(
+        string_view s,
+        error_code& ec);
+
     /** Set the userinfo.
 
         Sets the userinfo of the URL to the given
@@ -428,6 +584,27 @@ public:
     set_userinfo_part(
         string_view s);
 
+    /** Set the userinfo.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_userinfo_part(
+        string_view s,
+        error_code& ec);
+
     /** Return the user.
 
         This function returns the user portion of
@@ -461,6 +638,37 @@ public:
             encoded_user(), a);
     }
 
+    /** Return the user, decoding only if needed.
+
+        If the user contains no escapes, the returned
+        string refers to the characters of the URL and
+        nothing is copied. Otherwise the user is decoded
+        into `dest`, and the returned string refers to
+        the decoded characters there. A buffer of
+        `encoded_user().size()` characters is always
+        large enough.
+
+        @par Exception Safety
+
+        Strong guarantee.
+
+        @param dest The buffer to decode into.
+
+        @param cap The size of the buffer.
+
+        @throw too_large The decoded user does not fit.
+    */
+    string_view
+    user(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            encoded_user(),
+            pt_.has_pct(detail::id_user),
+            dest, cap);
+    }
+
     /** Return the user.
 
         This function returns the user portion of
@@ -540,6 +748,27 @@ public:
     set_encoded_user(
         string_view s);
 
+    /** Set the user.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_user(
+        string_view s,
+        error_code& ec);
+
     /** Return the password.
 
         @par Exception Safety
@@ -566,6 +795,21 @@ public:
             encoded_password(), a);
     }
 
+    /** Return the password, decoding only if needed.
+
+        @see user
+    */
+    string_view
+    password(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            encoded_password(),
+            pt_.has_pct(detail::id_password),
+            dest, cap);
+    }
+
     /** Return the password.
 
         This function returns the password portion of
@@ -664,6 +908,27 @@ public:
     set_encoded_password(
         string_view s);
 
+    /** Set the password.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_password(
+        string_view s,
+        error_code& ec);
+
     /** Set the password.
 
         The password part is set to the encoded string
@@ -700,6 +965,27 @@ public:
     set_password_part(
         string_view s);
 
+    /** Set the password.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_password_part(
+        string_view s,
+        error_code& ec);
+
     //------------------------------------------------------
     //
     // host
@@ -718,6 +1004,36 @@ public:
         return pt_.host;
     }
 
+    /** Return the IPv4 address of the host.
+
+        If the host is an IPv4 address, this
+        function returns the address recorded when
+        the host was parsed, otherwise it returns
+        the unspecified address `0.0.0.0`.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    BOOST_URL_DECL
+    urls::ipv4_address
+    ipv4_address() const noexcept;
+
+    /** Return the IPv6 address of the host.
+
+        If the host is an IPv6 address, this
+        function returns the address recorded when
+        the host was parsed, otherwise it returns
+        the unspecified address `::`.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    BOOST_URL_DECL
+    urls::ipv6_address
+    ipv6_address() const noexcept;
+
     /** Return the host and port.
 
         This function returns the encoded host and port,
@@ -771,6 +1087,26 @@ public:
             encoded_host(), a);
     }
 
+    /** Return the host, decoding only if needed.
+
+        An IP address host never contains escapes
+        and is always returned as it appears in
+        the URL.
+
+        @see user
+    */
+    string_view
+    host(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            encoded_host(),
+            pt_.host == urls::host_type::name &&
+                pt_.has_pct(detail::id_host),
+            dest, cap);
+    }
+
     /** Return the host.
 
         This function returns the host portion of
@@ -906,6 +1242,27 @@ public:
     set_encoded_host(
         string_view s);
 
+    /** Set the host.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_host(
+        string_view s,
+        error_code& ec);
+
     /** Return the port.
 
         If the URL contains a port, this function
@@ -921,6 +1278,52 @@ public:
     string_view
     port() const noexcept;
 
+    /** Return the port number.
+
+        If the URL contains a non-empty port,
+        this function returns its value, which was
+        computed when the URL was parsed. Otherwise,
+        zero is returned.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    std::uint16_t
+    port_number() const noexcept
+    {
+        if(pt_.length(detail::id_port) > 1)
+            return pt_.port_number;
+        return 0;
+    }
+
+    /** Return the port number to use for a connection.
+
+        If the URL contains a non-empty port,
+        its value is returned. Otherwise the
+        default port for a known scheme is
+        returned, or zero if there is none.
+
+        @par Example
+        @code
+        assert( url( "https://example.com" ).effective_port() == 443 );
+        assert( url( "https://example.com:8443" ).effective_port() == 8443 );
+        @endcode
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @see default_port
+    */
+    std::uint16_t
+    effective_port() const noexcept
+    {
+        if(pt_.length(detail::id_port) > 1)
+            return pt_.port_number;
+        return default_port(pt_.scheme_id);
+    }
+
     /** Return the port.
 
         If the URL contains a port, this function
@@ -994,6 +1397,27 @@ public:
     url_base&
     set_port(string_view s);
 
+    /** Set the port.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_port(
+        string_view s,
+        error_code& ec);
+
     /** Set the port.
 
         The port of the URL is set to the specified string.
@@ -1031,6 +1455,27 @@ public:
     url_base&
     set_port_part(string_view s);
 
+    /** Set the port.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_port_part(
+        string_view s,
+        error_code& ec);
+
     //------------------------------------------------------
     //
     // path
@@ -1106,6 +1551,27 @@ public:
     set_encoded_path(
         string_view s);
 
+    /** Set the path.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_path(
+        string_view s,
+        error_code& ec);
+
     /** Return the path.
 
         This function returns the path segments
@@ -1123,6 +1589,30 @@ public:
     url_view::segments_type
     segments() const noexcept;
 
+    /** Return the path with random access.
+
+        This function returns the path segments
+        as a read-only container with random access.
+        The offset of each segment is recorded in the
+        index, which must remain valid while the
+        container is used. Modifying the URL
+        invalidates the container.
+
+        @par Exception Safety
+
+        Strong guarantee.
+
+        @throw too_large The index does not have
+        room for all of the segments.
+
+        @param idx The index to fill.
+
+        @see url_view::indexed_segments_type
+    */
+    inline
+    url_view::indexed_segments_type
+    segments(basic_segments_index& idx) const;
+
     /** Return the path.
 
         This function returns the path segments
@@ -1189,6 +1679,21 @@ public:
             encoded_query(), a);
     }
 
+    /** Return the query, decoding only if needed.
+
+        @see user
+    */
+    string_view
+    query(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            encoded_query(),
+            pt_.has_pct(detail::id_query),
+            dest, cap);
+    }
+
     /** Return the query.
 
         This function returns the query of the URL:
@@ -1312,6 +1817,27 @@ public:
     set_encoded_query(
         string_view s);
 
+    /** Set the query.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_query(
+        string_view s,
+        error_code& ec);
+
     /** Set the query.
 
         Sets the query of the URL to the specified
@@ -1346,6 +1872,27 @@ public:
     set_query_part(
         string_view s);
 
+    /** Set the query.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_query_part(
+        string_view s,
+        error_code& ec);
+
     /** Return the query.
 
         This function returns the query parameters
@@ -1363,6 +1910,31 @@ public:
     url_view::params_type
     params() const noexcept;
 
+    /** Return the query parameters with hashed lookup.
+
+        This function returns the query parameters
+        as a read-only container with constant-time
+        `find` and `count`. The location of each
+        parameter is recorded in the index, which
+        must remain valid while the container is
+        used. Modifying the URL invalidates the
+        container.
+
+        @par Exception Safety
+
+        Strong guarantee.
+
+        @throw too_large The index does not have
+        room for all of the parameters.
+
+        @param idx The index to fill.
+
+        @see url_view::indexed_params_type
+    */
+    inline
+    url_view::indexed_params_type
+    params(basic_params_index& idx) const;
+
     /** Return the query.
 
         This function returns the query parameters
@@ -1429,6 +2001,21 @@ public:
             encoded_fragment(), a);
     }
 
+    /** Return the fragment, decoding only if needed.
+
+        @see user
+    */
+    string_view
+    fragment(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            encoded_fragment(),
+            pt_.has_pct(detail::id_frag),
+            dest, cap);
+    }
+
     /** Return the fragment.
 
         This function returns the fragment of the URL:
@@ -1556,6 +2143,27 @@ public:
     set_encoded_fragment(
         string_view s);
 
+    /** Set the fragment.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_fragment(
+        string_view s,
+        error_code& ec);
+
     /** Set the fragment.
 
         Sets the fragment of the URL to the specified
@@ -1592,6 +2200,27 @@ public:
     set_fragment_part(
         string_view s);
 
+    /** Set the fragment.
+
+        This overload reports failures by setting
+        `ec` rather than throwing an exception.
+        On error the URL is left unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_fragment_part(
+        string_view s,
+        error_code& ec);
+
     //------------------------------------------------------
     //
     // normalization
@@ -1599,6 +2228,34 @@ public:
     //------------------------------------------------------
 
     /** Normalize everything.
+
+        This function applies the syntax-based
+        normalizations of rfc3986 section 6.2.2
+        to the URL:
+
+        @li The scheme and host are made lower case.
+
+        @li Escaped unreserved characters are
+        decoded, and the hex digits of the
+        remaining escapes are made upper case.
+
+        @li Dot segments are removed from an
+        absolute path as described in rfc3986
+        section 5.2.4.
+
+        @li An empty port is removed.
+
+        None of these lengthen the string, so the
+        URL is rewritten in place in a single pass
+        and no memory is allocated. The result is
+        @ref equivalent to the original.
+
+        @par Example
+        @code
+        url u( "HTTP://www.Example.com:/a/./b/../c/%7euser%2f" );
+        u.normalize();
+        assert( u.encoded_url() == "http://www.example.com/a/c/~user%2F" );
+        @endcode
     */
     BOOST_URL_DECL
     url_base&
@@ -1611,6 +2268,9 @@ public:
 private:
     inline char* resize(int id, std::size_t new_size);
     inline char* resize(int first, int last, std::size_t new_size);
+
+    BOOST_URL_DECL static std::size_t view_size(url_view const& v) noexcept;
+    BOOST_URL_DECL void copy_view(char* s, url_view const& v) noexcept;
 };
 
 //----------------------------------------------------------
@@ -1762,13 +2422,15 @@ public:
 class url_base::segments_type::value_type
 {
     string_view s_;
+    bool pct_; // may contain escapes
 
     friend class segments_type;
 
-    explicit
     value_type(
-        string_view s) noexcept
+        string_view s,
+        bool pct) noexcept
         : s_(s)
+        , pct_(pct)
     {
     }
 
@@ -1811,6 +2473,27 @@ public:
             encoded_string(), a);
     }
 
+    /** Return the segment, decoding only if needed.
+
+        If the segment contains no escapes, the
+        returned string refers to the characters of
+        the URL and nothing is copied. Otherwise the
+        segment is decoded into `dest`. A buffer of
+        `encoded_string().size()` characters is
+        always large enough.
+
+        @throw too_large The decoded segment
+        does not fit.
+    */
+    string_view
+    string(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            s_, pct_, dest, cap);
+    }
+
     value_type const*
     operator->() const noexcept
     {
@@ -1994,14 +2677,19 @@ class url_base::params_type::value_type
 {
     string_view k_;
     string_view v_;
+    // bit 0 key, bit 1 value
+    // may contain escapes
+    unsigned char pct_;
 
     friend class params_type;
 
     value_type(
         string_view k,
-        string_view v) noexcept
+        string_view v,
+        unsigned char pct) noexcept
         : k_(k)
         , v_(v)
+        , pct_(pct)
     {
     }
 
@@ -2050,6 +2738,25 @@ public:
             encoded_key(), a);
     }
 
+    /** Return the key, decoding only if needed.
+
+        If the key contains no escapes, the returned
+        string refers to the characters of the URL and
+        nothing is copied. Otherwise the key is decoded
+        into `dest`. A buffer of `encoded_key().size()`
+        characters is always large enough.
+
+        @throw too_large The decoded key does not fit.
+    */
+    string_view
+    key(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            k_, (pct_ & 1) != 0, dest, cap);
+    }
+
     /** Return the value.
 
         @par Exception Safety
@@ -2075,6 +2782,19 @@ public:
             encoded_value(), a);
     }
 
+    /** Return the value, decoding only if needed.
+
+        @see key
+    */
+    string_view
+    value(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            v_, (pct_ & 2) != 0, dest, cap);
+    }
+
     value_type const*
     operator->() const noexcept
     {
@@ -2100,6 +2820,7 @@ class url_base::params_type::iterator
     std::size_t off_;
     std::size_t nk_;
     std::size_t nv_;
+    unsigned char pct_;
 
     BOOST_URL_DECL
     iterator(
@@ -0,0 +1,185 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_URL_PARSER_HPP
+#define BOOST_URL_URL_PARSER_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/parts.hpp>
+
+namespace boost {
+namespace urls {
+
+/** An incremental parser for URLs arriving in pieces.
+
+    This parser accepts a URI-reference which is
+    delivered over several calls, such as a request
+    target read from a socket. Each call to @ref write
+    passes all of the input received so far; the
+    parser continues from where the previous call
+    stopped instead of starting over.
+
+    The URL ends at the first character which cannot
+    continue it, for example the space following the
+    request target in an HTTP request line, or at
+    the end of the input when @ref finish is called.
+
+    Paths, queries, and fragments are resumed in the
+    middle. The scheme is resumed from its lookahead
+    position, while an authority which is split across
+    calls is examined again once it is complete.
+
+    @par Example
+    @code
+    url_parser pr;
+    error_code ec;
+    std::string buf;
+    for(;;)
+    {
+        buf.append( read_some() );
+        pr.write( buf, ec );
+        if( ec != error::need_more )
+            break;
+    }
+    if(! ec)
+    {
+        url_view u = pr.finish( buf, ec );
+    }
+    @endcode
+*/
+class url_parser
+{
+    enum class state : unsigned char
+    {
+        scheme,
+        hier,
+        authority,
+        path,
+        query_key,
+        query_value,
+        fragment,
+        done
+    };
+
+    enum class path_kind : unsigned char
+    {
+        abempty,
+        absolute,
+        rootless,
+        noscheme
+    };
+
+    detail::parts pt_;
+    std::size_t pos_ = 0;
+    std::size_t scan_ = 0;
+    std::size_t nslash_ = 0;
+    std::size_t nparam_ = 0;
+    state st_ = state::scheme;
+    path_kind kind_ = path_kind::abempty;
+    bool relative_ = false;
+    bool first_ = false;
+
+public:
+    /** Constructor.
+
+        Default-constructed parsers are ready
+        to receive the first piece of input.
+    */
+    url_parser() = default;
+
+    /** Prepare the parser for a new URL.
+    */
+    BOOST_URL_DECL
+    void
+    reset() noexcept;
+
+    /** Return true if the end of the URL was found.
+    */
+    bool
+    is_done() const noexcept
+    {
+        return st_ == state::done;
+    }
+
+    /** Parse more input.
+
+        The string passed in must contain all of the
+        input received so far, with the characters
+        passed in previous calls unchanged. The
+        string may live in a different buffer on
+        each call.
+
+        If the end of the URL was not yet seen,
+        `ec` is set to @ref error::need_more.
+        Otherwise, `ec` is cleared, and the return
+        value is the size of the URL.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @return The number of characters consumed.
+
+        @param s The input received so far.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    write(
+        string_view s,
+        error_code& ec) noexcept;
+
+    /** Indicate the end of input, and return the URL.
+
+        This completes parsing using the characters
+        which have not yet been consumed, then returns
+        a view of the URL at the front of `s`, using
+        the offsets already computed.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @param s The complete input. This must be
+        the same as, or a continuation of, the
+        string passed to the last call to
+        @ref write. The returned view references
+        this string.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_view
+    finish(
+        string_view s,
+        error_code& ec) noexcept;
+
+private:
+    BOOST_URL_DECL
+    void
+    step(
+        string_view s,
+        bool eof,
+        error_code& ec) noexcept;
+
+    inline
+    void
+    end_path(char const* begin) noexcept;
+};
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/url_parser.ipp>
+#endif
+
+#endif
@@ -11,8 +11,16 @@
 #define BOOST_URL_URL_VIEW_HPP
 
 #include <boost/url/config.hpp>
+#include <boost/url/ipv4_address.hpp>
+#include <boost/url/ipv6_address.hpp>
+#include <boost/url/scheme.hpp>
 #include <boost/url/detail/parts.hpp>
 #include <boost/url/detail/char_type.hpp>
+#include <boost/url/detail/parse.hpp>
+#include <boost/url/params_index.hpp>
+#include <boost/url/segments_index.hpp>
+#include <cstddef>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
@@ -21,6 +29,19 @@ namespace boost {
 namespace urls {
 
 class url_base;
+class url_parser;
+class url_view;
+template<class T>
+class result;
+
+namespace literals {
+BOOST_URL_CONSTEVAL
+inline
+url_view
+operator""_url(
+    char const* s,
+    std::size_t n);
+} // literals
 
 /** A parsed reference to a URL string.
 */
@@ -29,9 +50,67 @@ class url_view
     char const* s_ = "";
     detail::parts pt_;
 
+    friend class url_parser;
+    friend class url_base;
+
+    friend
+    BOOST_URL_CONSTEVAL
+    inline
+    url_view
+    literals::operator""_url(
+        char const* s,
+        std::size_t n);
+
+    friend BOOST_URL_DECL
+    result<url_view>
+    parse_uri(string_view s) noexcept;
+
+    friend BOOST_URL_DECL
+    result<url_view>
+    parse_relative_ref(string_view s) noexcept;
+
+    friend BOOST_URL_DECL
+    result<url_view>
+    parse_uri_reference(string_view s) noexcept;
+
+    friend BOOST_URL_DECL
+    result<url_view>
+    parse_origin_form(string_view s) noexcept;
+
+    friend BOOST_URL_DECL
+    result<url_view>
+    parse_absolute_form(string_view s) noexcept;
+
+    friend BOOST_URL_DECL
+    result<url_view>
+    parse_authority_form(string_view s) noexcept;
+
+    friend BOOST_URL_DECL
+    result<url_view>
+    parse_asterisk_form(string_view s) noexcept;
+
+    friend BOOST_URL_DECL
+    void
+    resolve(
+        url_view const& base,
+        url_view const& ref,
+        url_base& dest,
+        error_code& ec);
+
+    constexpr
+    url_view(
+        char const* s,
+        detail::parts const& pt) noexcept
+        : s_(s)
+        , pt_(pt)
+    {
+    }
+
 public:
     class segments_type;
+    class indexed_segments_type;
     class params_type;
+    class indexed_params_type;
 
     url_view() = default;
 
@@ -45,6 +124,7 @@ public:
 
     /** Return the number of characters in the URL.
     */
+    BOOST_URL_CONSTEXPR
     std::size_t
     size() const noexcept
     {
@@ -54,6 +134,7 @@ public:
 
     /** Return a pointer to the characters in the URL.
     */
+    BOOST_URL_CONSTEXPR
     char const*
     data() const noexcept
     {
@@ -86,6 +167,24 @@ public:
     string_view
     scheme() const noexcept;
 
+    /** Return the known scheme, if any.
+
+        The scheme is classified when the URL is
+        parsed, so no string comparison is made.
+        If the scheme is absent or is not one of
+        the special schemes, @ref scheme::unknown
+        is returned.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    urls::scheme
+    scheme_id() const noexcept
+    {
+        return pt_.scheme_id;
+    }
+
     //------------------------------------------------------
     //
     // authority
@@ -194,6 +293,37 @@ public:
             encoded_user(), a);
     }
 
+    /** Return the user, decoding only if needed.
+
+        If the user contains no escapes, the returned
+        string refers to the characters of the URL and
+        nothing is copied. Otherwise the user is decoded
+        into `dest`, and the returned string refers to
+        the decoded characters there. A buffer of
+        `encoded_user().size()` characters is always
+        large enough.
+
+        @par Exception Safety
+
+        Strong guarantee.
+
+        @param dest The buffer to decode into.
+
+        @param cap The size of the buffer.
+
+        @throw too_large The decoded user does not fit.
+    */
+    string_view
+    user(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            encoded_user(),
+            pt_.has_pct(detail::id_user),
+            dest, cap);
+    }
+
     /** Return the user.
 
         This function returns the user portion of
@@ -224,6 +354,21 @@ public:
             encoded_password(), a);
     }
 
+    /** Return the password, decoding only if needed.
+
+        @see user
+    */
+    string_view
+    password(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            encoded_password(),
+            pt_.has_pct(detail::id_password),
+            dest, cap);
+    }
+
     /** Return the password.
     */
     BOOST_URL_DECL
@@ -248,6 +393,36 @@ public:
         return pt_.host;
     }
 
+    /** Return the IPv4 address of the host.
+
+        If the host is an IPv4 address, this
+        function returns the address recorded when
+        the host was parsed, otherwise it returns
+        the unspecified address `0.0.0.0`.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    BOOST_URL_DECL
+    urls::ipv4_address
+    ipv4_address() const noexcept;
+
+    /** Return the IPv6 address of the host.
+
+        If the host is an IPv6 address, this
+        function returns the address recorded when
+        the host was parsed, otherwise it returns
+        the unspecified address `::`.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    BOOST_URL_DECL
+    urls::ipv6_address
+    ipv6_address() const noexcept;
+
     /** Return the host and port.
 
         This function returns the encoded host and port,
@@ -301,6 +476,26 @@ public:
             encoded_host(), a);
     }
 
+    /** Return the host, decoding only if needed.
+
+        An IP address host never contains escapes
+        and is always returned as it appears in
+        the URL.
+
+        @see user
+    */
+    string_view
+    host(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            encoded_host(),
+            pt_.host == urls::host_type::name &&
+                pt_.has_pct(detail::id_host),
+            dest, cap);
+    }
+
     /** Return the host.
 
         This function returns the host portion of
@@ -330,6 +525,52 @@ public:
     string_view
     port() const noexcept;
 
+    /** Return the port number.
+
+        If the URL contains a non-empty port,
+        this function returns its value, which was
+        computed when the URL was parsed. Otherwise,
+        zero is returned.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    std::uint16_t
+    port_number() const noexcept
+    {
+        if(pt_.length(detail::id_port) > 1)
+            return pt_.port_number;
+        return 0;
+    }
+
+    /** Return the port number to use for a connection.
+
+        If the URL contains a non-empty port,
+        its value is returned. Otherwise the
+        default port for a known scheme is
+        returned, or zero if there is none.
+
+        @par Example
+        @code
+        assert( url_view( "https://example.com" ).effective_port() == 443 );
+        assert( url_view( "https://example.com:8443" ).effective_port() == 8443 );
+        @endcode
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @see default_port
+    */
+    std::uint16_t
+    effective_port() const noexcept
+    {
+        if(pt_.length(detail::id_port) > 1)
+            return pt_.port_number;
+        return default_port(pt_.scheme_id);
+    }
+
     /** Return the port.
 
         If the URL contains a port, this function
@@ -363,6 +604,27 @@ public:
     segments_type
     segments() const noexcept;
 
+    /** Return the path segments as a read-only random access container.
+
+        The offset of each segment is recorded in
+        the index, which is filled in one pass over
+        the path. The returned container refers to
+        the index, which must remain valid while
+        the container is used.
+
+        @par Exception Safety
+
+        Strong guarantee.
+
+        @throw too_large The index does not have
+        room for all of the segments.
+
+        @param idx The index to fill.
+    */
+    inline
+    indexed_segments_type
+    segments(basic_segments_index& idx) const;
+
     //------------------------------------------------------
     //
     // query
@@ -412,6 +674,21 @@ public:
             encoded_query(), a);
     }
 
+    /** Return the query, decoding only if needed.
+
+        @see user
+    */
+    string_view
+    query(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            encoded_query(),
+            pt_.has_pct(detail::id_query),
+            dest, cap);
+    }
+
     /** Return the query.
 
         This function returns the query of the URL:
@@ -478,6 +755,28 @@ public:
     params_type
     params() const noexcept;
 
+    /** Return the query parameters as a read-only hashed container.
+
+        The location and decoded key hash of each
+        parameter is recorded in the index, which
+        is filled in one pass over the query. The
+        returned container refers to the index,
+        which must remain valid while the container
+        is used.
+
+        @par Exception Safety
+
+        Strong guarantee.
+
+        @throw too_large The index does not have
+        room for all of the parameters.
+
+        @param idx The index to fill.
+    */
+    inline
+    indexed_params_type
+    params(basic_params_index& idx) const;
+
     //------------------------------------------------------
     //
     // fragment
@@ -527,6 +826,21 @@ public:
             encoded_fragment(), a);
     }
 
+    /** Return the fragment, decoding only if needed.
+
+        @see user
+    */
+    string_view
+    fragment(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            encoded_fragment(),
+            pt_.has_pct(detail::id_frag),
+            dest, cap);
+    }
+
     /** Return the fragment.
 
         This function returns the fragment of the URL:
@@ -645,13 +959,16 @@ public:
 class url_view::segments_type::value_type
 {
     string_view s_;
+    bool pct_; // may contain escapes
 
     friend class segments_type;
+    friend class indexed_segments_type;
 
-    explicit
     value_type(
-        string_view s) noexcept
+        string_view s,
+        bool pct) noexcept
         : s_(s)
+        , pct_(pct)
     {
     }
 
@@ -679,6 +996,27 @@ public:
             encoded_string(), a);
     }
 
+    /** Return the segment, decoding only if needed.
+
+        If the segment contains no escapes, the
+        returned string refers to the characters of
+        the URL and nothing is copied. Otherwise the
+        segment is decoded into `dest`. A buffer of
+        `encoded_string().size()` characters is
+        always large enough.
+
+        @throw too_large The decoded segment
+        does not fit.
+    */
+    string_view
+    string(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            s_, pct_, dest, cap);
+    }
+
     value_type const*
     operator->() const noexcept
     {
@@ -763,6 +1101,280 @@ private:
 
 //----------------------------------------------------------
 
+/** A read-only view to the path segments with random access.
+
+    The segments are located through a
+    @ref basic_segments_index, so that
+    indexing and iterator arithmetic take
+    constant time.
+
+    @see url_view::segments
+*/
+class url_view::indexed_segments_type
+{
+    char const* s_ = nullptr;
+    std::size_t const* v_ = nullptr;
+    std::size_t n_ = 0;
+
+    friend class url_view;
+    friend class url_base;
+
+    indexed_segments_type(
+        char const* s,
+        std::size_t const* v,
+        std::size_t n) noexcept
+        : s_(s)
+        , v_(v)
+        , n_(n)
+    {
+    }
+
+    static
+    inline
+    segments_type::value_type
+    get(char const* s,
+        std::size_t const* v) noexcept;
+
+public:
+    using value_type =
+        segments_type::value_type;
+    class iterator;
+    using const_iterator = iterator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    indexed_segments_type() = default;
+    indexed_segments_type(
+        indexed_segments_type const&) = default;
+    indexed_segments_type& operator=(
+        indexed_segments_type const&) = default;
+
+    bool
+    empty() const noexcept
+    {
+        return n_ == 0;
+    }
+
+    std::size_t
+    size() const noexcept
+    {
+        return n_;
+    }
+
+    /** Return the segment at the specified position.
+
+        @par Precondition
+        `i < size()`
+    */
+    value_type
+    operator[](std::size_t i) const noexcept
+    {
+        BOOST_ASSERT(i < n_);
+        return get(s_, v_ + i);
+    }
+
+    value_type
+    front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    value_type
+    back() const noexcept
+    {
+        return (*this)[n_ - 1];
+    }
+
+    inline
+    iterator
+    begin() const noexcept;
+
+    inline
+    iterator
+    end() const noexcept;
+};
+
+//----------------------------------------------------------
+
+class url_view::indexed_segments_type::iterator
+{
+    friend indexed_segments_type;
+
+    char const* s_ = nullptr;
+    std::size_t const* v_ = nullptr;
+
+    iterator(
+        char const* s,
+        std::size_t const* v) noexcept
+        : s_(s)
+        , v_(v)
+    {
+    }
+
+public:
+    /// Elements are returned by value, as a proxy
+    /// reference, like the iterators of
+    /// `std::vector<bool>`. The traversal is
+    /// random access, in constant time.
+    using iterator_category =
+        std::random_access_iterator_tag;
+
+    using value_type =
+        indexed_segments_type::value_type;
+
+    using pointer = void;
+
+    /// Elements are returned by value
+    using reference = value_type;
+
+    /// The difference_type for this iterator
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+
+    value_type
+    operator*() const noexcept
+    {
+        return get(s_, v_);
+    }
+
+    value_type
+    operator->() const noexcept
+    {
+        return operator*();
+    }
+
+    value_type
+    operator[](difference_type n) const noexcept
+    {
+        return get(s_, v_ + n);
+    }
+
+    iterator&
+    operator++() noexcept
+    {
+        ++v_;
+        return *this;
+    }
+
+    iterator
+    operator++(int) noexcept
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    iterator&
+    operator--() noexcept
+    {
+        --v_;
+        return *this;
+    }
+
+    iterator
+    operator--(int) noexcept
+    {
+        auto tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    iterator&
+    operator+=(difference_type n) noexcept
+    {
+        v_ += n;
+        return *this;
+    }
+
+    iterator&
+    operator-=(difference_type n) noexcept
+    {
+        v_ -= n;
+        return *this;
+    }
+
+    friend
+    iterator
+    operator+(
+        iterator it,
+        difference_type n) noexcept
+    {
+        return it += n;
+    }
+
+    friend
+    iterator
+    operator+(
+        difference_type n,
+        iterator it) noexcept
+    {
+        return it += n;
+    }
+
+    friend
+    iterator
+    operator-(
+        iterator it,
+        difference_type n) noexcept
+    {
+        return it -= n;
+    }
+
+    friend
+    difference_type
+    operator-(
+        iterator a,
+        iterator b) noexcept
+    {
+        return a.v_ - b.v_;
+    }
+
+    bool
+    operator==(
+        iterator other) const noexcept
+    {
+        return v_ == other.v_;
+    }
+
+    bool
+    operator!=(
+        iterator other) const noexcept
+    {
+        return v_ != other.v_;
+    }
+
+    bool
+    operator<(
+        iterator other) const noexcept
+    {
+        return v_ < other.v_;
+    }
+
+    bool
+    operator>(
+        iterator other) const noexcept
+    {
+        return v_ > other.v_;
+    }
+
+    bool
+    operator<=(
+        iterator other) const noexcept
+    {
+        return v_ <= other.v_;
+    }
+
+    bool
+    operator>=(
+        iterator other) const noexcept
+    {
+        return v_ >= other.v_;
+    }
+};
+
+//----------------------------------------------------------
+
 /** A read-only view to the URL query parameters.
 */
 class url_view::params_type
@@ -770,6 +1382,8 @@ class url_view::params_type
     char const* s_ = nullptr;
     detail::parts const* pt_ = nullptr;
 
+    friend class indexed_params_type;
+
 public:
     class value_type;
     class iterator;
@@ -843,14 +1457,19 @@ class url_view::params_type::value_type
 {
     string_view k_;
     string_view v_;
+    // bit 0 key, bit 1 value
+    // may contain escapes
+    unsigned char pct_;
 
     friend class params_type;
 
     value_type(
         string_view k,
-        string_view v) noexcept
+        string_view v,
+        unsigned char pct) noexcept
         : k_(k)
         , v_(v)
+        , pct_(pct)
     {
         }
 
@@ -884,6 +1503,25 @@ public:
             encoded_key(), a);
     }
 
+    /** Return the key, decoding only if needed.
+
+        If the key contains no escapes, the returned
+        string refers to the characters of the URL and
+        nothing is copied. Otherwise the key is decoded
+        into `dest`. A buffer of `encoded_key().size()`
+        characters is always large enough.
+
+        @throw too_large The decoded key does not fit.
+    */
+    string_view
+    key(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            k_, (pct_ & 1) != 0, dest, cap);
+    }
+
     template<
         class Allocator =
             std::allocator<char>>
@@ -894,6 +1532,19 @@ public:
             encoded_value(), a);
     }
 
+    /** Return the value, decoding only if needed.
+
+        @see key
+    */
+    string_view
+    value(
+        char* dest,
+        std::size_t cap) const
+    {
+        return detail::decode_view(
+            v_, (pct_ & 2) != 0, dest, cap);
+    }
+
     value_type const*
     operator->() const noexcept
     {
@@ -914,18 +1565,33 @@ public:
 class url_view::params_type::iterator
 {
     friend params_type;
+    friend class indexed_params_type;
 
     char const* s_;
     detail::parts const* pt_;
     std::size_t off_;
     std::size_t nk_;
     std::size_t nv_;
+    unsigned char pct_;
 
     BOOST_URL_DECL
     iterator(
         params_type const* v,
         bool end) noexcept;
 
+    iterator(
+        params_type const* v,
+        std::size_t const* e) noexcept
+        : s_(v->s_)
+        , pt_(v->pt_)
+        , off_(e[0] >> 2)
+        , nk_(e[1])
+        , nv_(e[2])
+        , pct_(static_cast<
+            unsigned char>(e[0] & 3))
+    {
+    }
+
 public:
     using value_type =
         params_type::value_type;
@@ -985,6 +1651,142 @@ private:
     parse() noexcept;
 };
 
+//----------------------------------------------------------
+
+/** A read-only view to the URL query parameters with hashed lookup.
+
+    Keys are located through a
+    @ref basic_params_index, so that `find`,
+    `count` and `contains` take constant time
+    on average and never allocate.
+
+    @see url_view::params
+*/
+class url_view::indexed_params_type
+{
+    params_type p_;
+    basic_params_index const* idx_ = nullptr;
+
+    friend class url_view;
+    friend class url_base;
+
+    indexed_params_type(
+        params_type const& p,
+        basic_params_index const& idx) noexcept
+        : p_(p)
+        , idx_(&idx)
+    {
+    }
+
+public:
+    using value_type =
+        params_type::value_type;
+    using iterator =
+        params_type::iterator;
+    using const_iterator = iterator;
+
+    indexed_params_type() = default;
+    indexed_params_type(
+        indexed_params_type const&) = default;
+    indexed_params_type& operator=(
+        indexed_params_type const&) = default;
+
+    bool
+    empty() const noexcept
+    {
+        return p_.empty();
+    }
+
+    std::size_t
+    size() const noexcept
+    {
+        return p_.size();
+    }
+
+    iterator
+    begin() const noexcept
+    {
+        return p_.begin();
+    }
+
+    iterator
+    end() const noexcept
+    {
+        return p_.end();
+    }
+
+    BOOST_URL_DECL
+    bool
+    contains(string_view key) const noexcept;
+
+    BOOST_URL_DECL
+    std::size_t
+    count(string_view key) const noexcept;
+
+    /** Return the first parameter with a matching key.
+
+        The key is compared against the decoded
+        parameter keys. If there is no match,
+        `end()` is returned.
+    */
+    BOOST_URL_DECL
+    iterator
+    find(string_view key) const noexcept;
+
+    BOOST_URL_DECL
+    std::string
+    operator[](string_view key) const;
+
+    template<class Allocator =
+        std::allocator<char>>
+    string_type<Allocator>
+    at( string_view key,
+        Allocator const& a = {}) const;
+};
+
+//----------------------------------------------------------
+
+namespace literals {
+
+/** Return a view of a URL literal.
+
+    The literal is parsed as a <em>URI-reference</em>.
+    When the compiler supports constant evaluation of
+    the parser, parsing happens at compile time, and
+    an invalid literal is a compile error. Otherwise
+    the literal is parsed when the expression is
+    evaluated, and an exception is thrown if it is
+    invalid.
+
+    @par Example
+    @code
+    using namespace boost::urls::literals;
+
+    constexpr url_view u =
+        "https://www.example.com/index.htm"_url;
+    @endcode
+
+    @throw invalid_part The literal is not a
+    valid URI-reference.
+*/
+BOOST_URL_CONSTEVAL
+inline
+url_view
+operator""_url(
+    char const* s,
+    std::size_t n)
+{
+    detail::parts pt;
+    detail::error_value ec;
+    detail::parse_url(
+        pt, string_view(s, n), ec);
+    if(ec)
+        invalid_part::raise();
+    return url_view(s, pt);
+}
+
+} // literals
+
 } // urls
 } // boost
 
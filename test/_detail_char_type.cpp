@@ -155,7 +155,7 @@ public:
                 "abcdefghijklmnopqrstuvwxyz"
                 "-._~"
                 // sub-delims
-                "!$&'()*+,;" // minus '='
+                "!$'()*+,;" // minus '=' and '&'
                 // ':' / '@' / '/' / '?'
                 ":@/?"
             );
@@ -181,10 +181,337 @@ public:
         }
     }
 
+    // reference implementation
+    static
+    std::size_t
+    parse_len(
+        string_view s,
+        pct_encoding e,
+        bool& failed)
+    {
+        failed = false;
+        std::size_t i = 0;
+        while(i < s.size())
+        {
+            if(s[i] == '%')
+            {
+                if( s.size() - i < 3 ||
+                    hex_digit(s[i + 1]) == -1 ||
+                    hex_digit(s[i + 2]) == -1)
+                {
+                    failed = true;
+                    return i;
+                }
+                i += 3;
+                continue;
+            }
+            if(e.is_special(s[i]))
+                break;
+            ++i;
+        }
+        return i;
+    }
+
+    void
+    check_parse(
+        string_view s,
+        pct_encoding e)
+    {
+        bool failed;
+        auto const n =
+            parse_len(s, e, failed);
+        error_code ec;
+        auto const p = e.parse(
+            s.data(), s.data() + s.size(), ec);
+        BOOST_TEST(static_cast<std::size_t>(
+            p - s.data()) == n);
+        BOOST_TEST(!! ec == failed);
+        if(! failed)
+        {
+            ec = {};
+            (void)e.decoded_size(
+                s.substr(0, n), ec);
+            BOOST_TEST(! ec);
+        }
+    }
+
+    void
+    testParse()
+    {
+        // exercise the block scanner with
+        // the interesting character at
+        // every offset, including the tails
+        std::string const base =
+            "abcdefghijklmnopqrstuvwxyz"
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+            "0123456789-._~";
+        string_view const inserts[] = {
+            "", "%41", "%", "%4", "%zz",
+            "/", "?", "#", "@", ":", "=",
+            "&", "!", " ", "\x7f", "\x80",
+            "\xff", "[", "`", "{", "%2F/" };
+        pct_encoding const sets[] = {
+            reg_name_pct_set(),
+            userinfo_pct_set(),
+            pchar_pct_set(),
+            pchar_nc_pct_set(),
+            frag_pct_set(),
+            qkey_pct_set(),
+            qval_pct_set() };
+        for(auto const& e : sets)
+        {
+            for(std::size_t n = 0;
+                n <= base.size(); ++n)
+            {
+                for(std::size_t i = 0;
+                    i <= n; ++i)
+                {
+                    for(auto const& x : inserts)
+                    {
+                        std::string s =
+                            base.substr(0, i);
+                        s.append(x.data(), x.size());
+                        s.append(base, i, n - i);
+                        check_parse(s, e);
+                    }
+                }
+            }
+        }
+    }
+
+    // byte at a time, for comparison
+    static
+    std::string
+    ref_decode(string_view s)
+    {
+        std::string r;
+        for(std::size_t i = 0;
+            i < s.size(); ++i)
+        {
+            if(s[i] != '%')
+            {
+                r.push_back(s[i]);
+                continue;
+            }
+            r.push_back(static_cast<char>(
+                16 * hex_digit(s[i + 1]) +
+                    hex_digit(s[i + 2])));
+            i += 2;
+        }
+        return r;
+    }
+
+    void
+    check_decode(string_view s)
+    {
+        auto const r = ref_decode(s);
+        BOOST_TEST(pct_encoding::
+            raw_decoded_size(s) == r.size());
+
+        // exact size, with guard bytes
+        // to catch writes past the end
+        std::string buf(r.size() + 64, '*');
+        auto const end =
+            pct_encoding::decode(&buf[0], s);
+        BOOST_TEST(static_cast<std::size_t>(
+            end - &buf[0]) == r.size());
+        BOOST_TEST(buf.compare(
+            0, r.size(), r) == 0);
+        BOOST_TEST(buf.find_first_not_of(
+            '*', r.size()) == std::string::npos);
+
+        // worst case size, in one pass
+        std::string buf2(s.size(), '*');
+        auto const end2 = pct_encoding::
+            decode_upper_bound(&buf2[0], s);
+        BOOST_TEST(string_view(buf2.data(),
+            end2 - buf2.data()) == r);
+
+        BOOST_TEST(decode(s,
+            std::allocator<char>{}) == r);
+    }
+
+    void
+    testDecode()
+    {
+        BOOST_TEST(hex_value('0') == 0);
+        BOOST_TEST(hex_value('9') == 9);
+        BOOST_TEST(hex_value('a') == 10);
+        BOOST_TEST(hex_value('A') == 10);
+        BOOST_TEST(hex_value('f') == 15);
+        BOOST_TEST(hex_value('F') == 15);
+
+        check_decode("");
+        check_decode("%00");
+        check_decode("%ff%FF%7e%20");
+
+        // escapes at every offset of the
+        // block decoder, including the
+        // tails and adjacent escapes
+        std::string const base =
+            "abcdefghijklmnopqrstuvwxyz"
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+            "0123456789-._~";
+        string_view const inserts[] = {
+            "%41", "%2f%2F", "%e4%b8%ad",
+            "%25", "%00%0a" };
+        for(std::size_t n = 0;
+            n <= base.size(); ++n)
+        {
+            for(std::size_t i = 0;
+                i <= n; ++i)
+            {
+                for(auto const& x : inserts)
+                {
+                    std::string s =
+                        base.substr(0, i);
+                    s.append(x.data(), x.size());
+                    s.append(base, i, n - i);
+                    check_decode(s);
+                }
+            }
+        }
+
+        // escapes only
+        std::string s;
+        for(int i = 0; i < 100; ++i)
+        {
+            s.append("%3A");
+            check_decode(s);
+        }
+    }
+
+    void
+    testNibbles()
+    {
+        // the nibble tables must describe
+        // the same sets as the full tables
+        struct set
+        {
+            char const* tab;
+            char const* nib;
+        };
+        set const sets[] = {
+            { char_tables<>::reg_name, char_tables<>::reg_name_nib },
+            { char_tables<>::userinfo, char_tables<>::userinfo_nib },
+            { char_tables<>::pchar, char_tables<>::pchar_nib },
+            { char_tables<>::pchar_nc, char_tables<>::pchar_nc_nib },
+            { char_tables<>::frag, char_tables<>::frag_nib },
+            { char_tables<>::qkey, char_tables<>::qkey_nib },
+            { char_tables<>::qval, char_tables<>::qval_nib } };
+        for(auto const& e : sets)
+        {
+            for(unsigned c = 0; c < 256; ++c)
+            {
+                auto const nib = static_cast<
+                    unsigned char>(e.nib[c & 0xf]);
+                bool const in = c < 128 &&
+                    ((nib >> (c >> 4)) & 1) != 0;
+                BOOST_TEST(in == (e.tab[c] == '\1'));
+            }
+        }
+    }
+
+    // byte at a time, for comparison
+    static
+    std::string
+    ref_encode(
+        string_view s,
+        pct_encoding e)
+    {
+        static constexpr char hex[] =
+            "0123456789ABCDEF";
+        std::string r;
+        for(char c : s)
+        {
+            if(! e.is_special(c))
+            {
+                r.push_back(c);
+                continue;
+            }
+            auto const u = static_cast<
+                unsigned char>(c);
+            r.push_back('%');
+            r.push_back(hex[u >> 4]);
+            r.push_back(hex[u & 0xf]);
+        }
+        return r;
+    }
+
+    void
+    check_encode(
+        string_view s,
+        pct_encoding e)
+    {
+        auto const r = ref_encode(s, e);
+        BOOST_TEST(e.encoded_size(s) == r.size());
+        // exact size, with guard bytes
+        // to catch writes past the end
+        std::string buf(r.size() + 64, '*');
+        BOOST_TEST(e.encode(
+            &buf[0], s) == r.size());
+        BOOST_TEST(buf.compare(
+            0, r.size(), r) == 0);
+        BOOST_TEST(buf.find_first_not_of(
+            '*', r.size()) == std::string::npos);
+    }
+
+    void
+    testEncode()
+    {
+        // specials at every offset of the
+        // block encoder, including the tails
+        std::string const base =
+            "abcdefghijklmnopqrstuvwxyz"
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+            "0123456789-._~";
+        string_view const inserts[] = {
+            "", " ", "%", "/", "?", "#", "@",
+            ":", "=", "&", "[]", "\x7f",
+            "\x80", "\xe4\xb8\xad", "\xff", "\0" };
+        pct_encoding const sets[] = {
+            reg_name_pct_set(),
+            userinfo_pct_set(),
+            pchar_pct_set(),
+            pchar_nc_pct_set(),
+            frag_pct_set(),
+            qkey_pct_set(),
+            qval_pct_set() };
+        for(auto const& e : sets)
+        {
+            for(std::size_t n = 0;
+                n <= base.size(); ++n)
+            {
+                for(std::size_t i = 0;
+                    i <= n; ++i)
+                {
+                    for(auto const& x : inserts)
+                    {
+                        std::string s =
+                            base.substr(0, i);
+                        s.append(x.data(), x.size());
+                        s.append(base, i, n - i);
+                        check_encode(s, e);
+                    }
+                }
+            }
+
+            // every byte value
+            std::string all;
+            for(unsigned c = 0; c < 256; ++c)
+                all.push_back(static_cast<char>(c));
+            check_encode(all, e);
+        }
+    }
+
     void
     run()
     {
         testEncodings();
+        testParse();
+        testDecode();
+        testNibbles();
+        testEncode();
     }
 };
 
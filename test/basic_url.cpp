@@ -9,3 +9,429 @@
 
 // Test that header file is self-contained.
 #include <boost/url/basic_url.hpp>
+
+#include <boost/url/url.hpp>
+
+#include "test_suite.hpp"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+class basic_url_test
+{
+public:
+    // counts the allocations made through it
+    template<class T>
+    struct counting_allocator
+        : std::allocator<T>
+    {
+        std::size_t* n;
+
+        template<class U>
+        struct rebind
+        {
+            using other =
+                counting_allocator<U>;
+        };
+
+        explicit
+        counting_allocator(
+            std::size_t* n_ = nullptr) noexcept
+            : n(n_)
+        {
+        }
+
+        template<class U>
+        counting_allocator(
+            counting_allocator<U> const& other) noexcept
+            : n(other.n)
+        {
+        }
+
+        T*
+        allocate(std::size_t size)
+        {
+            ++*n;
+            return std::allocator<T>::allocate(size);
+        }
+    };
+
+    // counts the buffers outstanding, and
+    // propagates on assignment when P is set
+    template<class T, bool P>
+    struct stateful_allocator
+    {
+        using value_type = T;
+
+        using propagate_on_container_copy_assignment =
+            std::integral_constant<bool, P>;
+
+        using propagate_on_container_move_assignment =
+            std::integral_constant<bool, P>;
+
+        std::size_t* n;
+
+        template<class U>
+        struct rebind
+        {
+            using other =
+                stateful_allocator<U, P>;
+        };
+
+        explicit
+        stateful_allocator(
+            std::size_t* n_ = nullptr) noexcept
+            : n(n_)
+        {
+        }
+
+        template<class U>
+        stateful_allocator(
+            stateful_allocator<U, P> const& other) noexcept
+            : n(other.n)
+        {
+        }
+
+        T*
+        allocate(std::size_t size)
+        {
+            ++*n;
+            return static_cast<T*>(
+                ::operator new(size * sizeof(T)));
+        }
+
+        void
+        deallocate(T* p, std::size_t) noexcept
+        {
+            --*n;
+            ::operator delete(p);
+        }
+
+        friend
+        bool
+        operator==(
+            stateful_allocator const& a,
+            stateful_allocator const& b) noexcept
+        {
+            return a.n == b.n;
+        }
+
+        friend
+        bool
+        operator!=(
+            stateful_allocator const& a,
+            stateful_allocator const& b) noexcept
+        {
+            return a.n != b.n;
+        }
+    };
+
+    template<class U>
+    static
+    bool
+    is_inside(U const& u)
+    {
+        auto const p = u.encoded_url().data();
+        return
+            p >= reinterpret_cast<char const*>(&u) &&
+            p < reinterpret_cast<char const*>(&u + 1);
+    }
+
+    static
+    void
+    check_parts(
+        url_base const& u,
+        string_view s)
+    {
+        BOOST_TEST(u.encoded_url() == s);
+        url_view const v(s);
+        BOOST_TEST(u.encoded_host() == v.encoded_host());
+        BOOST_TEST(u.port_number() == v.port_number());
+        BOOST_TEST(u.segments().size() == v.segments().size());
+        BOOST_TEST(u.params().size() == v.params().size());
+    }
+
+    void
+    testInline()
+    {
+        using A = counting_allocator<char>;
+        std::size_t n = 0;
+
+        // no storage is used by default
+        {
+            basic_url<A, 24> u{A(&n)};
+            BOOST_TEST(u.capacity() == 24);
+            BOOST_TEST(u.encoded_url() == "");
+        }
+
+        // fits in the object
+        {
+            basic_url<A, 24> u("http://x.com/", A(&n));
+            BOOST_TEST(n == 0);
+            BOOST_TEST(u.capacity() == 24);
+            auto const p = u.encoded_url().data();
+            BOOST_TEST(
+                p >= reinterpret_cast<char const*>(&u) &&
+                p < reinterpret_cast<char const*>(&u + 1));
+            u.set_encoded_query("abc");
+            BOOST_TEST(n == 0);
+            BOOST_TEST(u.encoded_url() == "http://x.com/?abc");
+            BOOST_TEST(u.encoded_url().data() == p);
+        }
+        BOOST_TEST(n == 0);
+
+        // outgrows the object
+        {
+            basic_url<A, 24> u("http://x.com/", A(&n));
+            u.set_encoded_path("/a/long/path/to/a/file.txt");
+            BOOST_TEST(n == 1);
+            BOOST_TEST(u.capacity() > 24);
+            BOOST_TEST(u.encoded_url() ==
+                "http://x.com/a/long/path/to/a/file.txt");
+
+            // stays on the heap when it shrinks
+            u.set_encoded_path("/");
+            BOOST_TEST(u.encoded_url() == "http://x.com/");
+            u.set_encoded_fragment("f");
+            BOOST_TEST(n == 1);
+            BOOST_TEST(u.encoded_url() == "http://x.com/#f");
+        }
+
+        // too large from the start
+        {
+            std::string s = "http://x.com/";
+            s.append(100, 'a');
+            basic_url<A, 24> u(s, A(&n));
+            BOOST_TEST(n == 2);
+            BOOST_TEST(u.encoded_url() == s);
+        }
+
+        // without inline storage
+        {
+            n = 0;
+            basic_url<A> u("/", A(&n));
+            BOOST_TEST(n == 1);
+            BOOST_TEST(u.capacity() == 1);
+        }
+    }
+
+    void
+    testCopy()
+    {
+        using A = stateful_allocator<char, false>;
+        std::size_t n = 0;
+        auto const s0 = "http://u@example.com:81/a/b?k=v#f";
+        std::string s1 = "http://example.com/";
+        s1.append(40, 'x');
+        {
+            // inline
+            basic_url<A, 64> const u0(s0, A(&n));
+            basic_url<A, 64> u(u0);
+            BOOST_TEST(n == 0);
+            BOOST_TEST(is_inside(u));
+            check_parts(u, s0);
+        }
+        {
+            // one exact allocation
+            basic_url<A> const u0(s1, A(&n));
+            BOOST_TEST(n == 1);
+            basic_url<A> u(u0);
+            BOOST_TEST(n == 2);
+            BOOST_TEST(u.capacity() == s1.size());
+            BOOST_TEST(u.encoded_url().data() !=
+                u0.encoded_url().data());
+            check_parts(u, s1);
+        }
+        BOOST_TEST(n == 0);
+        {
+            // from a view
+            url_view const v(s1);
+            basic_url<A, 16> u(v, A(&n));
+            BOOST_TEST(n == 1);
+            BOOST_TEST(u.capacity() == s1.size());
+            check_parts(u, s1);
+            basic_url<A, 64> u2{url_view(s0), A(&n)};
+            BOOST_TEST(n == 1);
+            BOOST_TEST(is_inside(u2));
+            check_parts(u2, s0);
+        }
+        BOOST_TEST(n == 0);
+        {
+            // empty
+            basic_url<A> const u0{A(&n)};
+            basic_url<A> u(u0);
+            BOOST_TEST(u.encoded_url() == "");
+            BOOST_TEST(n == 0);
+        }
+        {
+            // assign reuses the buffer when it fits
+            basic_url<A> u(s1, A(&n));
+            basic_url<A> const u0(s0, A(&n));
+            BOOST_TEST(n == 2);
+            u = u0;
+            BOOST_TEST(n == 2);
+            check_parts(u, s0);
+            u = u;
+            check_parts(u, s0);
+            u = basic_url<A>{A(&n)};
+            BOOST_TEST(u.encoded_url() == "");
+            BOOST_TEST(u.segments().size() == 0);
+        }
+        BOOST_TEST(n == 0);
+        {
+            // the allocator is kept
+            std::size_t n1 = 0;
+            basic_url<A> u("/", A(&n));
+            basic_url<A> const u0(s1, A(&n1));
+            u = u0;
+            BOOST_TEST(n == 1);
+            BOOST_TEST(n1 == 1);
+            check_parts(u, s1);
+        }
+        BOOST_TEST(n == 0);
+        {
+            // the allocator propagates
+            using B = stateful_allocator<char, true>;
+            std::size_t n1 = 0;
+            basic_url<B> u(s1, B(&n));
+            basic_url<B> const u0("/", B(&n1));
+            u = u0;
+            BOOST_TEST(n == 0);
+            BOOST_TEST(n1 == 2);
+            check_parts(u, "/");
+            u.set_encoded_path(
+                "/" + std::string(40, 'x'));
+            BOOST_TEST(n == 0);
+            BOOST_TEST(n1 == 2);
+        }
+        BOOST_TEST(n == 0);
+    }
+
+    void
+    testMove()
+    {
+        using A = stateful_allocator<char, false>;
+        std::size_t n = 0;
+        auto const s0 = "http://u@example.com:81/a/b?k=v#f";
+        std::string s1 = "http://example.com/";
+        s1.append(40, 'x');
+        {
+            // the buffer is stolen
+            basic_url<A, 16> u0(s1, A(&n));
+            auto const p = u0.encoded_url().data();
+            basic_url<A, 16> u(std::move(u0));
+            BOOST_TEST(n == 1);
+            BOOST_TEST(u.encoded_url().data() == p);
+            check_parts(u, s1);
+            BOOST_TEST(u0.encoded_url() == "");
+            BOOST_TEST(u0.capacity() == 16);
+            BOOST_TEST(u0.segments().size() == 0);
+            // still usable
+            u0.set_encoded_url(s0);
+            check_parts(u0, s0);
+        }
+        BOOST_TEST(n == 0);
+        {
+            // inline chars are copied
+            basic_url<A, 64> u0(s0, A(&n));
+            basic_url<A, 64> u(std::move(u0));
+            BOOST_TEST(n == 0);
+            BOOST_TEST(is_inside(u));
+            check_parts(u, s0);
+            BOOST_TEST(u0.encoded_url() == "");
+        }
+        {
+            // equal allocators
+            basic_url<A> u0(s1, A(&n));
+            basic_url<A> u(s0, A(&n));
+            auto const p = u0.encoded_url().data();
+            u = std::move(u0);
+            BOOST_TEST(n == 1);
+            BOOST_TEST(u.encoded_url().data() == p);
+            check_parts(u, s1);
+            BOOST_TEST(u0.encoded_url() == "");
+        }
+        BOOST_TEST(n == 0);
+        {
+            // unequal allocators copy
+            std::size_t n1 = 0;
+            basic_url<A> u0(s1, A(&n1));
+            basic_url<A> u("/", A(&n));
+            u = std::move(u0);
+            BOOST_TEST(n == 1);
+            BOOST_TEST(n1 == 1);
+            check_parts(u, s1);
+            check_parts(u0, s1);
+        }
+        BOOST_TEST(n == 0);
+        {
+            // the allocator propagates
+            using B = stateful_allocator<char, true>;
+            std::size_t n1 = 0;
+            basic_url<B> u0(s1, B(&n1));
+            basic_url<B> u(s0, B(&n));
+            u = std::move(u0);
+            BOOST_TEST(n == 0);
+            BOOST_TEST(n1 == 1);
+            check_parts(u, s1);
+            BOOST_TEST(u0.encoded_url() == "");
+        }
+        BOOST_TEST(n == 0);
+    }
+
+    void
+    testContainer()
+    {
+        std::vector<url> v;
+        for(int i = 0; i < 100; ++i)
+        {
+            std::string s = "http://example.com/" +
+                std::to_string(i);
+            if(i % 2)
+                s.append(200, 'x');
+            v.push_back(url(s));
+        }
+        v.insert(v.begin(), v[50]);
+        for(int i = 0; i < 100; ++i)
+        {
+            std::string s = "http://example.com/" +
+                std::to_string(i);
+            if(i % 2)
+                s.append(200, 'x');
+            check_parts(v[i + 1], s);
+        }
+        check_parts(v[0], v[51].encoded_url());
+    }
+
+    void
+    testUrl()
+    {
+        // short URLs need no allocation
+        url u("https://www.example.com/index.html?q=1");
+        auto const p = u.encoded_url().data();
+        BOOST_TEST(
+            p >= reinterpret_cast<char const*>(&u) &&
+            p < reinterpret_cast<char const*>(&u + 1));
+        BOOST_TEST(u.capacity() == 128);
+    }
+
+    void
+    run()
+    {
+        testInline();
+        testCopy();
+        testMove();
+        testContainer();
+        testUrl();
+    }
+};
+
+TEST_SUITE(basic_url_test, "boost.url.basic_url");
+
+} // urls
+} // boost
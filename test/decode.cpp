@@ -0,0 +1,199 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/decode.hpp>
+
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include "test_suite.hpp"
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+class decode_test
+{
+public:
+    void
+    check(
+        string_view s,
+        string_view d)
+    {
+        BOOST_TEST(decoded_size(s) == d.size());
+
+        // caller buffer
+        char buf[128];
+        BOOST_TEST(decode_to(
+            s, buf, sizeof(buf)) == d);
+        BOOST_TEST(decode_to(
+            s, buf, d.size()) == d);
+        if(! d.empty())
+        {
+            std::string t(d.size() - 1, '*');
+            BOOST_TEST_THROWS(decode_to(
+                s, &t[0], t.size()), too_large);
+            // nothing written
+            BOOST_TEST(t == std::string(
+                d.size() - 1, '*'));
+        }
+
+        // output iterators
+        std::string r;
+        decode_to(s, std::back_inserter(r));
+        BOOST_TEST(r == d);
+        std::vector<char> v(d.size());
+        BOOST_TEST(decode_to(s, v.data()) ==
+            v.data() + v.size());
+        BOOST_TEST(string_view(
+            v.data(), v.size()) == d);
+
+        // append
+        std::string a = "x";
+        append_decoded(s, a);
+        BOOST_TEST(a == "x" + std::string(
+            d.data(), d.size()));
+    }
+
+    void
+    testDecode()
+    {
+        check("", "");
+        check("x", "x");
+        check("%20", " ");
+        check("a%2Fb%2fc", "a/b/c");
+        check("%e4%b8%ad%E6%96%87", "\xe4\xb8\xad\xe6\x96\x87");
+        check("%00", string_view("\0", 1));
+        check("the%20quick%20brown%20fox%20"
+            "jumps%20over%20the%20lazy%20dog",
+            "the quick brown fox "
+            "jumps over the lazy dog");
+    }
+
+    void
+    testAppend()
+    {
+        // no allocation when the
+        // capacity is sufficient
+        std::string s;
+        s.reserve(100);
+        auto const p = s.data();
+        append_decoded("abc%20", s);
+        append_decoded("%41%42%43", s);
+        BOOST_TEST(s == "abc ABC");
+        BOOST_TEST(s.data() == p);
+        s.clear();
+        append_decoded("", s);
+        BOOST_TEST(s.empty());
+    }
+
+    void
+    testComponents()
+    {
+        url_view const u(
+            "http://us%20er:pa%3Ass@ho%2Dst/a%2Fb/c%20d"
+            "?k%20=v%26&x=%41#fr%23ag");
+        char buf[32];
+        BOOST_TEST(decode_to(u.encoded_user(),
+            buf, sizeof(buf)) == "us er");
+        BOOST_TEST(decode_to(u.encoded_password(),
+            buf, sizeof(buf)) == "pa:ss");
+        BOOST_TEST(decode_to(u.encoded_host(),
+            buf, sizeof(buf)) == "ho-st");
+        BOOST_TEST(decode_to(u.encoded_fragment(),
+            buf, sizeof(buf)) == "fr#ag");
+        BOOST_TEST(decode_to(u.encoded_query(),
+            buf, sizeof(buf)) == u.query());
+
+        std::vector<std::string> v;
+        for(auto const& e : u.segments())
+        {
+            v.emplace_back();
+            append_decoded(
+                e.encoded_string(), v.back());
+            BOOST_TEST(v.back() == e.string());
+        }
+        BOOST_TEST(v.size() == 2);
+        for(auto const& e : u.params())
+        {
+            std::string k, x;
+            decode_to(e.encoded_key(),
+                std::back_inserter(k));
+            decode_to(e.encoded_value(),
+                std::back_inserter(x));
+            BOOST_TEST(k == e.key());
+            BOOST_TEST(x == e.value());
+        }
+
+        url w(u.encoded_url());
+        BOOST_TEST(decoded_size(
+            w.encoded_user()) == 5);
+        BOOST_TEST(decode_to(w.encoded_user(),
+            buf, sizeof(buf)) == "us er");
+    }
+
+    void
+    testInvalid()
+    {
+        auto const bad = [](
+            string_view s, error e)
+        {
+            error_code ec;
+            BOOST_TEST(decoded_size(s, ec) == 0);
+            BOOST_TEST(ec == e);
+
+            char buf[16];
+            BOOST_TEST_THROWS(decode_to(
+                s, buf, sizeof(buf)), invalid_part);
+
+            std::string r;
+            BOOST_TEST_THROWS(decode_to(
+                s, std::back_inserter(r)), invalid_part);
+            BOOST_TEST(r.empty());
+
+            std::string d = "x";
+            BOOST_TEST_THROWS(
+                append_decoded(s, d), invalid_part);
+            BOOST_TEST(d == "x");
+        };
+
+        bad("%", error::incomplete_pct_encoding);
+        bad("100%", error::incomplete_pct_encoding);
+        bad("a%4", error::incomplete_pct_encoding);
+        bad("%zz", error::bad_pct_encoding_digit);
+        bad("%4g", error::bad_pct_encoding_digit);
+
+        error_code ec;
+        BOOST_TEST(decoded_size("a%41%62", ec) == 3);
+        BOOST_TEST(! ec);
+        BOOST_TEST(decoded_size("", ec) == 0);
+        BOOST_TEST(! ec);
+
+        // any character set is accepted
+        BOOST_TEST(decoded_size("a b?#%25", ec) == 6);
+        BOOST_TEST(! ec);
+    }
+
+    void
+    run()
+    {
+        testDecode();
+        testAppend();
+        testComponents();
+        testInvalid();
+    }
+};
+
+TEST_SUITE(decode_test, "boost.url.decode");
+
+} // urls
+} // boost
@@ -0,0 +1,221 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/decoded_view.hpp>
+
+#include <boost/url/url_view.hpp>
+#include "test_suite.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+namespace boost {
+namespace urls {
+
+class decoded_view_test
+{
+public:
+    void
+    testIterator()
+    {
+        BOOST_TEST((std::is_same<
+            std::iterator_traits<decoded_view::iterator>::iterator_category,
+            std::forward_iterator_tag>::value));
+        BOOST_TEST((std::is_same<
+            std::iterator_traits<decoded_view::iterator>::reference,
+            char>::value));
+
+        auto const check = [](
+            string_view s, string_view d)
+        {
+            decoded_view const v(s);
+            std::string r(v.begin(), v.end());
+            BOOST_TEST(r == d);
+            BOOST_TEST(v.size() == d.size());
+            BOOST_TEST(v.empty() == d.empty());
+            BOOST_TEST(v.encoded() == s);
+            BOOST_TEST(static_cast<std::size_t>(
+                std::distance(v.begin(), v.end())) ==
+                    d.size());
+        };
+
+        check("", "");
+        check("abc", "abc");
+        check("%41", "A");
+        check("%41%42c", "ABc");
+        check("a%20b%2fc", "a b/c");
+        check("%25%32%35", "%25");
+        check("%00", string_view("\0", 1));
+
+        decoded_view const v("x%41y");
+        BOOST_TEST(*std::next(v.begin(), 2) == 'y');
+        auto it = v.begin();
+        BOOST_TEST(*it++ == 'x');
+        BOOST_TEST(*it == 'A');
+        ++it;
+        BOOST_TEST(*it == 'y');
+        BOOST_TEST(++it == v.end());
+        BOOST_TEST(decoded_view::iterator() ==
+            decoded_view::iterator());
+    }
+
+    void
+    testCompare()
+    {
+        decoded_view const v("a%20b");
+        BOOST_TEST(v.compare("a b") == 0);
+        BOOST_TEST(v.compare("a a") > 0);
+        BOOST_TEST(v.compare("a c") < 0);
+        BOOST_TEST(v.compare("a ") > 0);
+        BOOST_TEST(v.compare("a b ") < 0);
+        BOOST_TEST(v.compare("") > 0);
+        BOOST_TEST(v.compare("a%20b") < 0);
+        BOOST_TEST(decoded_view().compare("") == 0);
+
+        // unsigned, as with std::string
+        BOOST_TEST(decoded_view("%FF").compare("a") > 0);
+        BOOST_TEST(decoded_view("a").compare("\xff") < 0);
+
+        BOOST_TEST(v == "a b");
+        BOOST_TEST("a b" == v);
+        BOOST_TEST(v != "a%20b");
+        BOOST_TEST("a%20b" != v);
+
+        // both sides encoded
+        BOOST_TEST(v == decoded_view("%61 b"));
+        BOOST_TEST(v == decoded_view("%61%20%62"));
+        BOOST_TEST(v != decoded_view("a%20c"));
+        BOOST_TEST(v < decoded_view("a%20c"));
+        BOOST_TEST(! (v < decoded_view("a b")));
+        BOOST_TEST(v.compare(decoded_view("a")) > 0);
+    }
+
+    void
+    testAffixes()
+    {
+        decoded_view const v("/files/my%20report%2Epdf");
+        BOOST_TEST(v.starts_with(""));
+        BOOST_TEST(v.starts_with("/"));
+        BOOST_TEST(v.starts_with("/files/my "));
+        BOOST_TEST(v.starts_with("/files/my report.pdf"));
+        BOOST_TEST(! v.starts_with("/files/my report.pdfx"));
+        BOOST_TEST(! v.starts_with("/files/my%20"));
+        BOOST_TEST(! v.starts_with("/Files"));
+
+        BOOST_TEST(v.ends_with(""));
+        BOOST_TEST(v.ends_with(".pdf"));
+        BOOST_TEST(v.ends_with(" report.pdf"));
+        BOOST_TEST(v.ends_with("/files/my report.pdf"));
+        BOOST_TEST(! v.ends_with("x/files/my report.pdf"));
+        BOOST_TEST(! v.ends_with("%2Epdf"));
+        BOOST_TEST(! v.ends_with(".PDF"));
+
+        // escapes near the start
+        BOOST_TEST(decoded_view("%41").ends_with("A"));
+        BOOST_TEST(decoded_view("a%41").ends_with("aA"));
+        BOOST_TEST(decoded_view("ab").ends_with("ab"));
+        BOOST_TEST(! decoded_view("").ends_with("a"));
+        BOOST_TEST(! decoded_view("").starts_with("a"));
+
+        // an escaped percent sign
+        BOOST_TEST(decoded_view("%2541").ends_with("%41"));
+        BOOST_TEST(decoded_view("%2541").starts_with("%4"));
+    }
+
+    void
+    testICase()
+    {
+        decoded_view const v("Hello%20%57orld");
+        BOOST_TEST(v.compare_icase("hello world") == 0);
+        BOOST_TEST(v.compare_icase("HELLO WORLD") == 0);
+        BOOST_TEST(v.compare_icase("hello worle") < 0);
+        BOOST_TEST(v.compare_icase("hello") > 0);
+        BOOST_TEST(v.compare("hello world") != 0);
+        BOOST_TEST(v.starts_with_icase("HELLO w"));
+        BOOST_TEST(! v.starts_with_icase("HELLOW"));
+        BOOST_TEST(v.ends_with_icase("WORLD"));
+        BOOST_TEST(! v.ends_with_icase("WORLDS"));
+
+        // only ASCII letters fold
+        BOOST_TEST(decoded_view("[").compare_icase("{") != 0);
+        BOOST_TEST(decoded_view("@").compare_icase("`") != 0);
+        BOOST_TEST(decoded_view("%C0").compare_icase("\xe0") != 0);
+    }
+
+    void
+    testHash()
+    {
+        // independent of the encoding
+        BOOST_TEST(decoded_view("abc").hash() ==
+            decoded_view("%61b%63").hash());
+        BOOST_TEST(decoded_view("abc").hash() !=
+            decoded_view("abd").hash());
+        BOOST_TEST(decoded_view("a%20b").hash() ==
+            decoded_view("a b").hash());
+
+        // stable FNV-1a
+#if BOOST_URL_ARCH == 64
+        BOOST_TEST(decoded_view().hash() ==
+            14695981039346656037ULL);
+        BOOST_TEST(decoded_view("a").hash() ==
+            0xaf63dc4c8601ec8cULL);
+#else
+        BOOST_TEST(decoded_view().hash() ==
+            2166136261U);
+        BOOST_TEST(decoded_view("a").hash() ==
+            0xe40c292cU);
+#endif
+
+        BOOST_TEST(decoded_view("ABC").hash_icase() ==
+            decoded_view("%61b%43").hash_icase());
+        BOOST_TEST(decoded_view("abc").hash_icase() ==
+            decoded_view("abc").hash());
+        BOOST_TEST(decoded_view("ABC").hash_icase() !=
+            decoded_view("ABD").hash_icase());
+    }
+
+    void
+    testUrl()
+    {
+        // routing on a view, without allocating
+        url_view const u(
+            "https://Example.com/api/v1/us%65rs/42?sort=n%61me");
+        BOOST_TEST(decoded_view(u.encoded_host())
+            .compare_icase("example.com") == 0);
+        decoded_view const path(u.encoded_path());
+        BOOST_TEST(path.starts_with("/api/v1/"));
+        auto it = u.segments().begin();
+        ++it;
+        ++it;
+        BOOST_TEST(decoded_view(
+            it->encoded_string()) == "users");
+        auto const p = *u.params().begin();
+        BOOST_TEST(decoded_view(
+            p.encoded_value()) == "name");
+    }
+
+    void
+    run()
+    {
+        testIterator();
+        testCompare();
+        testAffixes();
+        testICase();
+        testHash();
+        testUrl();
+    }
+};
+
+TEST_SUITE(decoded_view_test, "boost.url.decoded_view");
+
+} // urls
+} // boost
@@ -0,0 +1,222 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/equivalent.hpp>
+
+#include <boost/url/url.hpp>
+#include "test_suite.hpp"
+
+#include <string>
+#include <unordered_map>
+
+namespace boost {
+namespace urls {
+
+class equivalent_test
+{
+public:
+    void
+    same(
+        string_view s0,
+        string_view s1)
+    {
+        url_view const u0(s0);
+        url_view const u1(s1);
+        BOOST_TEST(equivalent(u0, u1));
+        BOOST_TEST(equivalent(u1, u0));
+        BOOST_TEST(hash_normalized(u0) ==
+            hash_normalized(u1));
+    }
+
+    void
+    diff(
+        string_view s0,
+        string_view s1)
+    {
+        url_view const u0(s0);
+        url_view const u1(s1);
+        BOOST_TEST(! equivalent(u0, u1));
+        BOOST_TEST(! equivalent(u1, u0));
+        BOOST_TEST(hash_normalized(u0) !=
+            hash_normalized(u1));
+    }
+
+    // n is the normal form of s
+    void
+    norm(
+        string_view s,
+        string_view n)
+    {
+        same(s, n);
+        url u(n);
+        u.normalize();
+        BOOST_TEST(u.encoded_url() == n);
+    }
+
+    void
+    testCase()
+    {
+        same("HTTP://example.com", "http://example.com");
+        same("http://EXAMPLE.com", "http://example.com");
+        same("http://%45xample.com", "http://example.com");
+        same("http://[::A]/", "http://[::a]/");
+        diff("http://example.com/A", "http://example.com/a");
+        diff("http://U@h", "http://u@h");
+        diff("http://h?Q", "http://h?q");
+        diff("http://h#F", "http://h#f");
+    }
+
+    void
+    testEscapes()
+    {
+        same("/%7Euser", "/~user");
+        same("/%41%2d%2E%5F", "/A-._");
+        same("/%c3%a9", "/%C3%A9");
+        same("http://u%3a@h", "http://u%3A@h");
+        same("?k=%7e#%7e", "?k=~#~");
+        diff("/a%2Fb", "/a/b");
+        diff("?a%26b", "?a&b");
+        diff("http://a%3Ab@h", "http://a:b@h");
+        diff("/%25", "/%2525");
+    }
+
+    void
+    testDotSegments()
+    {
+        same("/a/./b", "/a/b");
+        same("/a/b/../c", "/a/c");
+        same("/a/b/./../c/", "/a/c/");
+        same("/a/b/..", "/a/");
+        same("/a/b/.", "/a/b/");
+        same("/..", "/");
+        same("/../a", "/a");
+        same("/a/../../b", "/b");
+        same("/a//..", "/a/");
+        same("/a/%2E%2e/b", "/b");
+        same("/a/%2E/b", "/a/b");
+        same("http://h/a/./b/../c", "http://h/a/c");
+        same("/a/..//b", "/.//b");
+
+        // kept in relative paths
+        diff("./a", "a");
+        diff("../a", "a");
+        diff("a/./b/../c", "a/c");
+        same("a/%2E/b", "a/./b");
+        diff("/a/.../b", "/a/b");
+        diff("/a/.b", "/a/b");
+        diff("/a/b", "/a/b/");
+        diff("/a", "a");
+        diff("/a//b", "/a/b");
+
+        // many pending ".."
+        {
+            std::string s0;
+            std::string s1;
+            for(int i = 0; i < 20000; ++i)
+            {
+                s0.append("/a");
+                s1.append(i < 10000 ?
+                    "/a" : "/b/..");
+            }
+            for(int i = 0; i < 10000; ++i)
+                s0.append("/..");
+            s0.append("/");
+            s1.append("/");
+            same(s0, s1);
+            diff(s0, s1.substr(2));
+        }
+    }
+
+    void
+    testPort()
+    {
+        same("http://h:80/", "http://h/");
+        same("https://h:443/", "https://h/");
+        same("http://h:/", "http://h/");
+        same("http://h:0080/", "http://h/");
+        same("http://h:8080/", "http://h:08080/");
+        diff("http://h:8080/", "http://h/");
+        diff("https://h:80/", "https://h/");
+        diff("x://h:0/", "x://h/");
+        diff("x://h:80/", "x://h/");
+    }
+
+    void
+    testHost()
+    {
+        same("http://[0:0::1]/", "http://[::1]/");
+        same("http://[::FFFF:1.2.3.4]/", "http://[::ffff:102:304]/");
+        diff("http://1.2.3.4/", "http://1.2.3.5/");
+        diff("http://[::1]/", "http://[::2]/");
+        diff("http://h/", "http://i/");
+        diff("http://h/", "/");
+        same("http:///", "HTTP:///");
+    }
+
+    void
+    testStructure()
+    {
+        diff("http://h", "http://h?");
+        diff("http://h", "http://h#");
+        diff("http://h?", "http://h#");
+        diff("http://@h", "http://h");
+        diff("http:/h", "http://h");
+        diff("http://h", "https://h");
+        diff("/a?b", "/a%3Fb");
+        same("", "");
+        same("?", "?");
+        diff("", "/");
+        diff("x:", "y:");
+    }
+
+    void
+    testNormalForm()
+    {
+        norm("HTTP://User@Example.COM:80/a/./%7e/../b?Q=%7a#F",
+            "http://User@example.com/a/b?Q=z#F");
+        norm("https://[0::1]:8443", "https://[::1]:8443");
+        norm("http://1.2.3.4:/%c3%a9", "http://1.2.3.4/%C3%A9");
+        norm("a/b/..", "a/b/..");
+        norm("/..", "/");
+        norm("", "");
+    }
+
+    void
+    testContainer()
+    {
+        std::unordered_map<
+            url_view, int,
+            normalized_hash,
+            normalized_equal> m;
+        m[url_view("http://example.com/a/b")] = 1;
+        m[url_view("HTTP://Example.com:80/a/./b")] = 2;
+        m[url_view("http://example.com/a/%62/")] = 3;
+        BOOST_TEST(m.size() == 2);
+        BOOST_TEST(m[url_view("http://example.com/a/c/../b")] == 2);
+    }
+
+    void
+    run()
+    {
+        testCase();
+        testEscapes();
+        testDotSegments();
+        testPort();
+        testHost();
+        testStructure();
+        testNormalForm();
+        testContainer();
+    }
+};
+
+TEST_SUITE(equivalent_test, "boost.url.equivalent");
+
+} // urls
+} // boost
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/ipv4_address.hpp>
+
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+class ipv4_address_test
+{
+public:
+    void
+    check(
+        std::uint32_t u,
+        string_view s)
+    {
+        char buf[ipv4_address::max_str_len];
+        BOOST_TEST(ipv4_address(u).to_buffer(
+            buf, sizeof(buf)) == s);
+    }
+
+    void
+    testAddress()
+    {
+        ipv4_address const a(0x01020304);
+        ipv4_address::bytes_type const b =
+            {{ 1, 2, 3, 4 }};
+        BOOST_TEST(a.to_bytes() == b);
+        BOOST_TEST(a.to_uint() == 0x01020304);
+        BOOST_TEST(a == ipv4_address(b));
+        BOOST_TEST(a != ipv4_address());
+        BOOST_TEST(ipv4_address().to_uint() == 0);
+
+        check(0, "0.0.0.0");
+        check(0x7f000001, "127.0.0.1");
+        check(0xc0a8000a, "192.168.0.10");
+        check(0xffffffff, "255.255.255.255");
+        check(0x0a636409, "10.99.100.9");
+
+        char buf[ipv4_address::max_str_len];
+        BOOST_TEST(ipv4_address(0x7f000001
+            ).to_buffer(buf, 9) == "127.0.0.1");
+        BOOST_TEST_THROWS(ipv4_address(0x7f000001
+            ).to_buffer(buf, 8), too_large);
+    }
+
+    void
+    testUrl()
+    {
+        BOOST_TEST(url_view("http://192.168.0.1/"
+            ).ipv4_address().to_uint() == 0xc0a80001);
+        BOOST_TEST(url_view("//u:p@10.0.0.255:80"
+            ).ipv4_address().to_uint() == 0x0a0000ff);
+        BOOST_TEST(url_view("//1.2.3.4.example.com"
+            ).ipv4_address() == ipv4_address());
+        BOOST_TEST(url_view("//[::1]"
+            ).ipv4_address() == ipv4_address());
+        BOOST_TEST(url_view("/path"
+            ).ipv4_address() == ipv4_address());
+
+        url u("http://example.com/");
+        BOOST_TEST(u.ipv4_address() == ipv4_address());
+        u.set_encoded_host("8.8.4.4");
+        BOOST_TEST(u.host_type() == host_type::ipv4);
+        BOOST_TEST(u.ipv4_address().to_uint() == 0x08080404);
+        u.set_host("example.com");
+        BOOST_TEST(u.ipv4_address() == ipv4_address());
+        u.set_encoded_authority("u@127.0.0.1:8080");
+        BOOST_TEST(u.host_type() == host_type::ipv4);
+        BOOST_TEST(u.ipv4_address().to_uint() == 0x7f000001);
+        u.set_encoded_origin("http://10.1.2.3");
+        BOOST_TEST(u.ipv4_address().to_uint() == 0x0a010203);
+        u.set_encoded_origin("");
+        BOOST_TEST(u.host_type() == host_type::none);
+        BOOST_TEST(u.ipv4_address() == ipv4_address());
+    }
+
+    void
+    run()
+    {
+        testAddress();
+        testUrl();
+    }
+};
+
+TEST_SUITE(ipv4_address_test, "boost.url.ipv4_address");
+
+} // urls
+} // boost
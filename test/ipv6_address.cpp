@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/ipv6_address.hpp>
+
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+class ipv6_address_test
+{
+public:
+    // parse `s` as the host of a
+    // URL and format it canonically
+    void
+    check(
+        string_view s,
+        string_view expected)
+    {
+        std::string const u =
+            "http://[" + std::string(
+                s.data(), s.size()) + "]/";
+        url_view const v(u);
+        if(! BOOST_TEST(
+            v.host_type() == host_type::ipv6))
+            return;
+        char buf[ipv6_address::max_str_len];
+        BOOST_TEST(v.ipv6_address().to_buffer(
+            buf, sizeof(buf)) == expected);
+    }
+
+    void
+    bad(string_view s)
+    {
+        std::string const u =
+            "http://[" + std::string(
+                s.data(), s.size()) + "]/";
+        BOOST_TEST_THROWS(url_view{u},
+            invalid_part);
+    }
+
+    void
+    testAddress()
+    {
+        ipv6_address::bytes_type b{};
+        BOOST_TEST(ipv6_address() ==
+            ipv6_address(b));
+        BOOST_TEST(! ipv6_address().is_v4_mapped());
+        b[15] = 1;
+        BOOST_TEST(ipv6_address(b).to_bytes() == b);
+        BOOST_TEST(ipv6_address(b) != ipv6_address());
+        b[10] = 0xff;
+        b[11] = 0xff;
+        BOOST_TEST(ipv6_address(b).is_v4_mapped());
+
+        char buf[ipv6_address::max_str_len];
+        BOOST_TEST(ipv6_address(b).to_buffer(
+            buf, sizeof(buf)) == "::ffff:0.0.0.1");
+        BOOST_TEST(ipv6_address().to_buffer(
+            buf, 2) == "::");
+        BOOST_TEST_THROWS(ipv6_address().to_buffer(
+            buf, 1), too_large);
+    }
+
+    void
+    testFormat()
+    {
+        check("::", "::");
+        check("::1", "::1");
+        check("1::", "1::");
+        check("0:0:0:0:0:0:0:1", "::1");
+        check("0:0:0:0:0:0:0:0", "::");
+        check("2001:DB8::1", "2001:db8::1");
+        check("2001:0db8:0000:0000:0000:0000:0002:0001",
+            "2001:db8::2:1");
+        check("2001:db8:0:1:1:1:1:1",
+            "2001:db8:0:1:1:1:1:1");
+        check("2001:db8:0:0:1:0:0:1", "2001:db8::1:0:0:1");
+        check("2001:0:0:1:0:0:0:1", "2001:0:0:1::1");
+        check("1:0:0:0:1:0:0:0", "1::1:0:0:0");
+        check("fe80::0202:b3ff:fe1e:8329",
+            "fe80::202:b3ff:fe1e:8329");
+        check("1:2:3:4:5:6:7:8", "1:2:3:4:5:6:7:8");
+        check("1:2:3:4:5:6::", "1:2:3:4:5:6::");
+        check("1:2:3:4:5:6:7::", "1:2:3:4:5:6:7:0");
+        check("::2:3:4:5:6:7:8", "0:2:3:4:5:6:7:8");
+        check("ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff",
+            "ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff");
+        check("::ffff:192.168.0.1", "::ffff:192.168.0.1");
+        check("0:0:0:0:0:FFFF:C0A8:0001", "::ffff:192.168.0.1");
+        check("::192.168.0.1", "::c0a8:1");
+        check("1:2:3:4:5:6:1.2.3.4", "1:2:3:4:5:6:102:304");
+        check("1::1.2.3.4", "1::102:304");
+    }
+
+    void
+    testParse()
+    {
+        bad("1:2:3:4:5:6:7:8:9");
+        bad("1:2:3:4:5:6:7");
+        bad("1::2::3");
+        bad(":1::2");
+        bad("1::2:");
+        bad("12345::");
+        bad("1:2:3:4:5:6:7:1.2.3.4");
+        bad("::1.2.3");
+        bad("::256.0.0.1");
+        bad("::1.2.3.4:5");
+        bad("g::");
+        bad("");
+    }
+
+    void
+    testUrl()
+    {
+        BOOST_TEST(url_view("http://1.2.3.4/"
+            ).ipv6_address() == ipv6_address());
+        BOOST_TEST(url_view("http://example.com/"
+            ).ipv6_address() == ipv6_address());
+
+        ipv6_address::bytes_type b{};
+        b[15] = 1;
+        BOOST_TEST(url_view("//u@[::1]:80/"
+            ).ipv6_address() == ipv6_address(b));
+
+        url u("http://example.com/");
+        u.set_encoded_host("[::1]");
+        BOOST_TEST(u.host_type() == host_type::ipv6);
+        BOOST_TEST(u.ipv6_address() == ipv6_address(b));
+        u.set_encoded_authority("[2001:db8::]:443");
+        char buf[ipv6_address::max_str_len];
+        BOOST_TEST(u.ipv6_address().to_buffer(
+            buf, sizeof(buf)) == "2001:db8::");
+        u.set_host("example.com");
+        BOOST_TEST(u.ipv6_address() == ipv6_address());
+    }
+
+    void
+    run()
+    {
+        testAddress();
+        testFormat();
+        testParse();
+        testUrl();
+    }
+};
+
+TEST_SUITE(ipv6_address_test, "boost.url.ipv6_address");
+
+} // urls
+} // boost
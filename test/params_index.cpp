@@ -0,0 +1,259 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/params_index.hpp>
+
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include <string>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+class params_index_test
+{
+public:
+    // compare the index against
+    // the linear lookups
+    void
+    check(
+        string_view s,
+        std::initializer_list<
+            string_view> keys)
+    {
+        url_view const u(s);
+        auto const p0 = u.params();
+        static_params_index<16> idx;
+        auto const p1 = u.params(idx);
+        BOOST_TEST(idx.size() == p0.size());
+        BOOST_TEST(p1.size() == p0.size());
+        BOOST_TEST(p1.empty() == p0.empty());
+        BOOST_TEST(p1.begin() == p0.begin());
+        BOOST_TEST(p1.end() == p0.end());
+        for(auto k : keys)
+        {
+            BOOST_TEST(p1.contains(k) == p0.contains(k));
+            BOOST_TEST(p1.count(k) == p0.count(k));
+            BOOST_TEST(p1.find(k) == p0.find(k));
+            if(p0.find(k) != p0.end())
+                BOOST_TEST(p1.find(k)->encoded_value() ==
+                    p0.find(k)->encoded_value());
+            BOOST_TEST(p1[k] == p0[k]);
+        }
+    }
+
+    void
+    testIndex()
+    {
+        check("/", { "", "a" });
+        check("/?", { "", "a" });
+        check("/?a", { "", "a", "b" });
+        check("/?a=1", { "a", "b", "1" });
+        check("/?a=1&b=2&c=3", { "a", "b", "c", "d", "1" });
+        check("/?a=1&b=2&a=3&a=4", { "a", "b" });
+        check("/?a=1&=2&=", { "", "a" });
+        check("/?k%31=v1&k1=v2", { "k1", "k%31", "k" });
+        check("/?a%20b=1&a+b=2", { "a b", "a+b", "a%20b" });
+        check("/?x=1#f", { "x", "f" });
+        check("/?x#f", { "x", "f" });
+        check("http://h/p?first=1&second=&third#frag",
+            { "first", "second", "third", "fourth" });
+        check("/?a&b", { "a", "b", "a&b" });
+        check("/?a%26b&c", { "a&b", "a", "b", "c" });
+    }
+
+    void
+    testValueless()
+    {
+        // a key with no value ends at
+        // '&', even when an escaped '&'
+        // appears in the key
+        url_view const u("/?a%26b&c=1&d&a%26b=2");
+        auto const p0 = u.params();
+        BOOST_TEST(p0.size() == 4);
+        auto it = p0.begin();
+        BOOST_TEST(it->encoded_key() == "a%26b");
+        BOOST_TEST(it->key() == "a&b");
+        BOOST_TEST(it->encoded_value().empty());
+        ++it;
+        BOOST_TEST(it->encoded_key() == "c");
+        BOOST_TEST(it->encoded_value() == "1");
+        ++it;
+        BOOST_TEST(it->encoded_key() == "d");
+        BOOST_TEST(it->encoded_value().empty());
+        ++it;
+        BOOST_TEST(it->key() == "a&b");
+        BOOST_TEST(it->encoded_value() == "2");
+        BOOST_TEST(++it == p0.end());
+        --it;
+        --it;
+        BOOST_TEST(it->encoded_key() == "d");
+
+        static_params_index<4> idx;
+        auto const p1 = u.params(idx);
+        BOOST_TEST(p1.count("a&b") == 2);
+        BOOST_TEST(p1.find("a&b") == p0.begin());
+        BOOST_TEST(p1.contains("d"));
+        BOOST_TEST(! p1.contains("a%26b"));
+        BOOST_TEST(! p1.contains("b&c"));
+
+        url v("/");
+        v.set_encoded_query("a%26b&c");
+        BOOST_TEST(v.params().size() == 2);
+        BOOST_TEST(static_cast<url const&>(
+            v).params(idx).contains("c"));
+    }
+
+    void
+    testDuplicates()
+    {
+        // duplicates are found in order
+        static_params_index<8> idx;
+        url_view const u("/?a=1&b=2&a=3&c=4&a=5");
+        auto const p = u.params(idx);
+        BOOST_TEST(p.count("a") == 3);
+        BOOST_TEST(p.count("b") == 1);
+        BOOST_TEST(p.count("z") == 0);
+        BOOST_TEST(p.find("a")->encoded_value() == "1");
+        BOOST_TEST(p.find("c")->encoded_value() == "4");
+        BOOST_TEST(p.at("b") == "2");
+        BOOST_TEST_THROWS(p.at("z"), out_of_range);
+        BOOST_TEST(p["z"].empty());
+    }
+
+    void
+    testEscapes()
+    {
+        // the index records escapes per
+        // parameter, so plain keys and
+        // values are never copied
+        static_params_index<8> idx;
+        url_view const u("/?a=1&b%20=2&c=%33&d");
+        auto const p = u.params(idx);
+        char buf[16];
+        auto it = p.find("a");
+        BOOST_TEST(it->key(buf, 0).data() ==
+            it->encoded_key().data());
+        BOOST_TEST(it->value(buf, 0).data() ==
+            it->encoded_value().data());
+        it = p.find("b ");
+        BOOST_TEST(it->key(buf, sizeof(buf)) == "b ");
+        BOOST_TEST(it->key(buf, sizeof(buf)).data() == buf);
+        BOOST_TEST(it->value(buf, 0) == "2");
+        it = p.find("c");
+        BOOST_TEST(it->key(buf, 0) == "c");
+        BOOST_TEST(it->value(buf, sizeof(buf)) == "3");
+        BOOST_TEST(it->value(buf, sizeof(buf)).data() == buf);
+        BOOST_TEST_THROWS(it->value(buf, 0), too_large);
+        it = p.find("d");
+        BOOST_TEST(it->key(buf, 0) == "d");
+        BOOST_TEST(it->value(buf, 0).empty());
+    }
+
+    void
+    testMany()
+    {
+        // more parameters than table
+        // slots would hold at one per key
+        std::string s = "/?";
+        for(int i = 0; i < 200; ++i)
+        {
+            if(i > 0)
+                s.push_back('&');
+            s += "key" + std::to_string(i) +
+                "=" + std::to_string(i * 2);
+        }
+        url_view const u(s);
+        static_params_index<200> idx;
+        auto const p = u.params(idx);
+        BOOST_TEST(p.size() == 200);
+        for(int i = 0; i < 200; ++i)
+        {
+            auto const k =
+                "key" + std::to_string(i);
+            auto const it = p.find(k);
+            if(! BOOST_TEST(it != p.end()))
+                continue;
+            BOOST_TEST(it->encoded_value() ==
+                std::to_string(i * 2));
+            BOOST_TEST(p.count(k) == 1);
+        }
+        BOOST_TEST(! p.contains("key200"));
+        BOOST_TEST(! p.contains("key"));
+    }
+
+    void
+    testStorage()
+    {
+        BOOST_TEST(basic_params_index::storage_size(0) == 1);
+        BOOST_TEST(basic_params_index::storage_size(1) == 6);
+        BOOST_TEST(basic_params_index::storage_size(3) == 20);
+
+        // caller-provided storage
+        std::size_t buf[basic_params_index::storage_size(2)];
+        basic_params_index idx(buf, 2);
+        BOOST_TEST(idx.capacity() == 2);
+        BOOST_TEST(idx.size() == 0);
+
+        url_view const u("/?a=1&b=2");
+        auto const p = u.params(idx);
+        BOOST_TEST(idx.size() == 2);
+        BOOST_TEST(p.find("b")->encoded_value() == "2");
+
+        // reuse for another URL
+        url_view const v("/?c=3");
+        auto const q = v.params(idx);
+        BOOST_TEST(idx.size() == 1);
+        BOOST_TEST(q.contains("c"));
+        BOOST_TEST(! q.contains("a"));
+
+        url_view const w("/?a=1&b=2&c=3");
+        BOOST_TEST_THROWS(w.params(idx), too_large);
+
+        url_view::indexed_params_type const e;
+        BOOST_TEST(e.empty());
+        BOOST_TEST(e.begin() == e.end());
+        BOOST_TEST(! e.contains("a"));
+        BOOST_TEST(e.count("a") == 0);
+    }
+
+    void
+    testUrl()
+    {
+        url u("http://h/?a=1");
+        static_params_index<4> idx;
+        BOOST_TEST(static_cast<url const&>(
+            u).params(idx).contains("a"));
+        u.set_encoded_query("x=1&y=2");
+        auto const p = static_cast<
+            url const&>(u).params(idx);
+        BOOST_TEST(! p.contains("a"));
+        BOOST_TEST(p.find("y")->encoded_value() == "2");
+    }
+
+    void
+    run()
+    {
+        testIndex();
+        testValueless();
+        testDuplicates();
+        testEscapes();
+        testMany();
+        testStorage();
+        testUrl();
+    }
+};
+
+TEST_SUITE(params_index_test, "boost.url.params_index");
+
+} // urls
+} // boost
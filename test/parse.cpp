@@ -0,0 +1,341 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/parse.hpp>
+
+#include <boost/url/equivalent.hpp>
+#include <boost/url/resolve.hpp>
+#include <boost/url/url.hpp>
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+class parse_api_test
+{
+public:
+    template<class F>
+    void
+    good(F const& f, string_view s)
+    {
+        auto const r = f(s);
+        if(! BOOST_TEST(r.has_value()))
+            return;
+        BOOST_TEST(! r.has_error());
+        BOOST_TEST(r.position() == s.size());
+        BOOST_TEST(r->encoded_url() == s);
+        BOOST_TEST(r->data() == s.data());
+    }
+
+    template<class F>
+    void
+    bad(F const& f,
+        string_view s,
+        error e,
+        std::size_t pos)
+    {
+        auto const r = f(s);
+        if(! BOOST_TEST(r.has_error()))
+            return;
+        BOOST_TEST(! r);
+        BOOST_TEST(r.error() == e);
+        BOOST_TEST(r.position() == pos);
+    }
+
+    void
+    testParseUri()
+    {
+        auto const f = &parse_uri;
+        good(f, "http:");
+        good(f, "http://www.example.com/path?q#f");
+        good(f, "x:y");
+        good(f, "x:/y");
+        good(f, "mailto:user@example.com");
+
+        bad(f, "", error::missing_scheme, 0);
+        bad(f, "/path", error::bad_scheme_start_char, 0);
+        bad(f, "//host", error::bad_scheme_start_char, 0);
+        bad(f, "http//x", error::bad_scheme_char, 4);
+        bad(f, "http://h/a b", error::syntax, 10);
+        bad(f, "http://h/%zz", error::bad_pct_encoding_digit, 9);
+        bad(f, "http://h/%2", error::incomplete_pct_encoding, 9);
+        bad(f, "http://h/?q#%", error::incomplete_pct_encoding, 12);
+        bad(f, "http://h/#a#", error::syntax, 11);
+    }
+
+    void
+    testParseRelativeRef()
+    {
+        auto const f = &parse_relative_ref;
+        good(f, "");
+        good(f, "/");
+        good(f, "//host");
+        good(f, "//user@host:80/a/b?q#f");
+        good(f, "a/b/c");
+        good(f, "?q");
+        good(f, "#f");
+
+        bad(f, "http://host", error::syntax, 4);
+        bad(f, "a:b", error::syntax, 1);
+        bad(f, "/a%g0", error::bad_pct_encoding_digit, 2);
+        bad(f, "//[::1", error::syntax, 6);
+    }
+
+    void
+    testParseUriReference()
+    {
+        auto const f = &parse_uri_reference;
+        good(f, "");
+        good(f, "http://www.example.com/");
+        good(f, "//host/path");
+        good(f, "path?q#f");
+
+        bad(f, "http://h/ ", error::syntax, 9);
+        bad(f, "a b", error::syntax, 1);
+        bad(f, "%", error::incomplete_pct_encoding, 0);
+
+        // agrees with the throwing constructor
+        for(string_view s : {
+            "x:", "x://", "//a@b:1/c?d#e",
+            "/a/b/./c", "a:%", "?%x" })
+        {
+            auto const r = f(s);
+            bool threw = false;
+            try
+            {
+                url_view u(s);
+                BOOST_TEST(r.has_value());
+                if(r)
+                    BOOST_TEST(r->encoded_url() ==
+                        u.encoded_url());
+            }
+            catch(std::exception const&)
+            {
+                threw = true;
+            }
+            BOOST_TEST(threw == r.has_error());
+        }
+    }
+
+    void
+    testParseOriginForm()
+    {
+        auto const f = &parse_origin_form;
+        good(f, "/");
+        good(f, "/index.html");
+        good(f, "/where?q=now");
+        good(f, "/a/b/c?x=1&y=2");
+        good(f, "/a:b/c@d");
+
+        {
+            auto const r = f("/a/b?q");
+            BOOST_TEST(r->scheme().empty());
+            BOOST_TEST(! r->has_authority());
+            BOOST_TEST(r->encoded_path() == "/a/b");
+            BOOST_TEST(r->encoded_query() == "q");
+            BOOST_TEST(r->segments().size() == 2);
+        }
+
+        bad(f, "", error::syntax, 0);
+        bad(f, "*", error::syntax, 0);
+        bad(f, "a/b", error::syntax, 0);
+        bad(f, "http://h/", error::syntax, 0);
+        bad(f, "/a#f", error::syntax, 2);
+        bad(f, "/a b", error::syntax, 2);
+        bad(f, "/%zz", error::bad_pct_encoding_digit, 1);
+        bad(f, "/?%", error::incomplete_pct_encoding, 2);
+
+        // would be read as an authority
+        bad(f, "//a", error::syntax, 1);
+        bad(f, "//a/b?x", error::syntax, 1);
+        bad(f, "//", error::syntax, 1);
+    }
+
+    void
+    testParseAbsoluteForm()
+    {
+        auto const f = &parse_absolute_form;
+        good(f, "http://www.example.org/pub/WWW/");
+        good(f, "http://h:80/a?q");
+        good(f, "urn:x");
+
+        {
+            auto const r = f("http://u@h:8080/p?q");
+            BOOST_TEST(r->scheme() == "http");
+            BOOST_TEST(r->encoded_authority() == "u@h:8080");
+            BOOST_TEST(r->encoded_path() == "/p");
+            BOOST_TEST(r->encoded_query() == "q");
+        }
+
+        bad(f, "", error::missing_scheme, 0);
+        bad(f, "/a", error::bad_scheme_start_char, 0);
+        bad(f, "http//", error::bad_scheme_char, 4);
+        bad(f, "http://h/#f", error::syntax, 9);
+        bad(f, "http://h/ ", error::syntax, 9);
+    }
+
+    void
+    testParseAuthorityForm()
+    {
+        auto const f = &parse_authority_form;
+        good(f, "www.example.com:80");
+        good(f, "127.0.0.1:443");
+        good(f, "[::1]:8080");
+
+        {
+            auto const r = f("www.example.com:80");
+            BOOST_TEST(r->scheme().empty());
+            BOOST_TEST(r->has_authority());
+            BOOST_TEST(! r->has_userinfo());
+            BOOST_TEST(r->encoded_authority() ==
+                "www.example.com:80");
+            BOOST_TEST(r->encoded_userinfo().empty());
+            BOOST_TEST(r->encoded_host() == "www.example.com");
+            BOOST_TEST(r->host_type() == host_type::name);
+            BOOST_TEST(r->port() == "80");
+            BOOST_TEST(r->encoded_path().empty());
+        }
+        {
+            auto const r = f("[::1]:8080");
+            BOOST_TEST(r->host_type() == host_type::ipv6);
+            BOOST_TEST(r->port() == "8080");
+        }
+
+        bad(f, "", error::missing_hostname, 0);
+        bad(f, ":80", error::missing_hostname, 0);
+        bad(f, "h", error::missing_port, 1);
+        bad(f, "h:", error::missing_port, 2);
+        bad(f, "u@h:80", error::syntax, 1);
+        bad(f, "h:80/", error::syntax, 4);
+        bad(f, "h:8x", error::syntax, 3);
+        bad(f, "//h:80", error::missing_hostname, 0);
+    }
+
+    void
+    testParseAsteriskForm()
+    {
+        auto const f = &parse_asterisk_form;
+        good(f, "*");
+
+        {
+            auto const r = f("*");
+            BOOST_TEST(! r->has_authority());
+            BOOST_TEST(r->encoded_path() == "*");
+            BOOST_TEST(r->segments().size() == 1);
+        }
+
+        bad(f, "", error::syntax, 0);
+        bad(f, "/", error::syntax, 0);
+        bad(f, "**", error::syntax, 1);
+        bad(f, "*?q", error::syntax, 1);
+    }
+
+    // A request-target copied into a url, normalized,
+    // resolved or compared means the same as the
+    // URL string s
+    void
+    roundTrip(
+        url_view const& v,
+        string_view s,
+        string_view resolved)
+    {
+        auto const check = [&](url const& u)
+        {
+            BOOST_TEST(u.encoded_url() == s);
+            url_view const u1(u.encoded_url());
+            BOOST_TEST(u.has_authority() == v.has_authority());
+            BOOST_TEST(u1.has_authority() == v.has_authority());
+            BOOST_TEST(u1.encoded_host() == v.encoded_host());
+            BOOST_TEST(u1.port() == v.port());
+            BOOST_TEST(u1.encoded_path() == v.encoded_path());
+            BOOST_TEST(u1.encoded_query() == v.encoded_query());
+            BOOST_TEST(u.encoded_host() == u1.encoded_host());
+            BOOST_TEST(u.encoded_path() == u1.encoded_path());
+            BOOST_TEST(u.segments().size() ==
+                u1.segments().size());
+        };
+
+        url u(v);
+        check(u);
+
+        url u2("http://user@example.com/index.html#f");
+        u2.assign(v);
+        check(u2);
+
+        u.normalize();
+        url_view const n(u.encoded_url());
+        BOOST_TEST(equivalent(n, v));
+        BOOST_TEST(n.encoded_path() == u.encoded_path());
+        BOOST_TEST(n.encoded_host() == u.encoded_host());
+
+        url r;
+        resolve(url_view("http://x/y/z"), v, r);
+        BOOST_TEST(r.encoded_url() == resolved);
+
+        BOOST_TEST(equivalent(v, url_view(s)));
+        BOOST_TEST(hash_normalized(v) ==
+            hash_normalized(url_view(s)));
+    }
+
+    void
+    testRoundTrip()
+    {
+        roundTrip(parse_origin_form("/").value(),
+            "/", "http://x/");
+        roundTrip(parse_origin_form("/a/b?x").value(),
+            "/a/b?x", "http://x/a/b?x");
+        roundTrip(parse_origin_form("/a/./b/../c?q").value(),
+            "/a/./b/../c?q", "http://x/a/c?q");
+        roundTrip(parse_origin_form("/a//b").value(),
+            "/a//b", "http://x/a//b");
+        roundTrip(parse_authority_form("h:80").value(),
+            "//h:80", "http://h:80");
+        roundTrip(parse_authority_form("[::1]:8080").value(),
+            "//[::1]:8080", "http://[::1]:8080");
+        roundTrip(parse_authority_form("Example.COM:443").value(),
+            "//Example.COM:443", "http://Example.COM:443");
+    }
+
+    void
+    testResult()
+    {
+        auto const r1 = parse_uri("http://h");
+        BOOST_TEST(r1.value().encoded_host() == "h");
+        BOOST_TEST((*r1).scheme() == "http");
+        BOOST_TEST(! r1.error());
+
+        auto const r2 = parse_uri("/");
+        BOOST_TEST_THROWS(r2.value(), system_error);
+
+        result<url_view> r3;
+        BOOST_TEST(r3.has_value());
+        BOOST_TEST(r3.position() == 0);
+        BOOST_TEST(r3->size() == 0);
+    }
+
+    void
+    run()
+    {
+        testParseUri();
+        testParseRelativeRef();
+        testParseUriReference();
+        testParseOriginForm();
+        testParseAbsoluteForm();
+        testParseAuthorityForm();
+        testParseAsteriskForm();
+        testRoundTrip();
+        testResult();
+    }
+};
+
+TEST_SUITE(parse_api_test, "boost.url.parse_api");
+
+} // urls
+} // boost
@@ -0,0 +1,220 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/resolve.hpp>
+
+#include <boost/url/parse.hpp>
+#include <boost/url/static_pool.hpp>
+#include <boost/url/url.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+class resolve_test
+{
+public:
+    void
+    check(
+        string_view base,
+        string_view ref,
+        string_view result)
+    {
+        url u;
+        resolve(url_view(base), url_view(ref), u);
+        BOOST_TEST(u.encoded_url() == result);
+        // the parts agree with a fresh parse
+        url_view const v(result);
+        BOOST_TEST(u.scheme() == v.scheme());
+        BOOST_TEST(u.scheme_id() == v.scheme_id());
+        BOOST_TEST(u.encoded_user() == v.encoded_user());
+        BOOST_TEST(u.encoded_password() == v.encoded_password());
+        BOOST_TEST(u.encoded_host() == v.encoded_host());
+        BOOST_TEST(u.host_type() == v.host_type());
+        BOOST_TEST(u.port() == v.port());
+        BOOST_TEST(u.port_number() == v.port_number());
+        BOOST_TEST(u.encoded_path() == v.encoded_path());
+        BOOST_TEST(u.segments().size() == v.segments().size());
+        BOOST_TEST(u.encoded_query() == v.encoded_query());
+        BOOST_TEST(u.params().size() == v.params().size());
+        BOOST_TEST(u.encoded_fragment() == v.encoded_fragment());
+    }
+
+    // rfc3986 section 5.4
+    void
+    testExamples()
+    {
+        auto const base = "http://a/b/c/d;p?q";
+
+        // normal
+        check(base, "g:h", "g:h");
+        check(base, "g", "http://a/b/c/g");
+        check(base, "./g", "http://a/b/c/g");
+        check(base, "g/", "http://a/b/c/g/");
+        check(base, "/g", "http://a/g");
+        check(base, "//g", "http://g");
+        check(base, "?y", "http://a/b/c/d;p?y");
+        check(base, "g?y", "http://a/b/c/g?y");
+        check(base, "#s", "http://a/b/c/d;p?q#s");
+        check(base, "g#s", "http://a/b/c/g#s");
+        check(base, "g?y#s", "http://a/b/c/g?y#s");
+        check(base, ";x", "http://a/b/c/;x");
+        check(base, "g;x", "http://a/b/c/g;x");
+        check(base, "g;x?y#s", "http://a/b/c/g;x?y#s");
+        check(base, "", "http://a/b/c/d;p?q");
+        check(base, ".", "http://a/b/c/");
+        check(base, "./", "http://a/b/c/");
+        check(base, "..", "http://a/b/");
+        check(base, "../", "http://a/b/");
+        check(base, "../g", "http://a/b/g");
+        check(base, "../..", "http://a/");
+        check(base, "../../", "http://a/");
+        check(base, "../../g", "http://a/g");
+
+        // abnormal
+        check(base, "../../../g", "http://a/g");
+        check(base, "../../../../g", "http://a/g");
+        check(base, "/./g", "http://a/g");
+        check(base, "/../g", "http://a/g");
+        check(base, "g.", "http://a/b/c/g.");
+        check(base, ".g", "http://a/b/c/.g");
+        check(base, "g..", "http://a/b/c/g..");
+        check(base, "..g", "http://a/b/c/..g");
+        check(base, "./../g", "http://a/b/g");
+        check(base, "./g/.", "http://a/b/c/g/");
+        check(base, "g/./h", "http://a/b/c/g/h");
+        check(base, "g/../h", "http://a/b/c/h");
+        check(base, "g;x=1/./y", "http://a/b/c/g;x=1/y");
+        check(base, "g;x=1/../y", "http://a/b/c/y");
+        check(base, "g?y/./x", "http://a/b/c/g?y/./x");
+        check(base, "g?y/../x", "http://a/b/c/g?y/../x");
+        check(base, "g#s/./x", "http://a/b/c/g#s/./x");
+        check(base, "g#s/../x", "http://a/b/c/g#s/../x");
+        check(base, "http:g", "http:g");
+    }
+
+    void
+    testResolve()
+    {
+        // empty base path
+        check("http://h", "g", "http://h/g");
+        check("http://h", "..", "http://h/");
+        check("http://u:p@h:81", "?q#f", "http://u:p@h:81?q#f");
+
+        // reference with authority
+        check("http://h/a/b", "//u@g:8/./x/../y?q", "http://u@g:8/y?q");
+        check("http://h/a/b", "//g", "http://g");
+        check("http://h/a/b", "//[::1]/x", "http://[::1]/x");
+        check("http://h/a/b", "//1.2.3.4:80", "http://1.2.3.4:80");
+
+        // base without authority
+        check("x:/a/b", "c", "x:/a/c");
+        check("x:/a/b", "..//c", "x:/.//c");
+        check("x:/a/b", "/..", "x:/");
+        check("x:a/b", "c", "x:a/c");
+        check("x:a/b", "..", "x:");
+        check("x:a", "../b", "x:b");
+        check("x:a/b", "..//c", "x:.//c");
+
+        // leading empty segments with authority
+        check("http://h/a/b", "..//c", "http://h//c");
+
+        // escapes are copied as they are
+        check("http://h/a%20b/c", "d%2F?%3D", "http://h/a%20b/d%2F?%3D");
+        check("http://h/a/b", "%2E%2E/c", "http://h/a/%2E%2E/c");
+
+        // an authority-form reference
+        // gets its "//"
+        {
+            url u;
+            resolve(url_view("http://x/b"),
+                parse_authority_form(
+                    "h:80").value(), u);
+            BOOST_TEST(u.encoded_url() == "http://h:80");
+            BOOST_TEST(u.encoded_host() == "h");
+            BOOST_TEST(u.port_number() == 80);
+            BOOST_TEST(u.encoded_path().empty());
+        }
+    }
+
+    void
+    testStorage()
+    {
+        // one exact allocation
+        {
+            basic_url<std::allocator<char>> u;
+            resolve(
+                url_view("http://example.com/a/b/c"),
+                url_view("../d?q=1"), u);
+            BOOST_TEST(u.encoded_url() ==
+                "http://example.com/a/d?q=1");
+            BOOST_TEST(u.capacity() == u.encoded_url().size());
+        }
+
+        // into a caller buffer
+        {
+            static_pool<256> sp;
+            basic_url<basic_static_pool::
+                allocator_type<char>> u(sp.allocator());
+            resolve(
+                url_view("http://example.com/a/b/c"),
+                url_view("../d?q=1#f"), u);
+            BOOST_TEST(u.encoded_url() ==
+                "http://example.com/a/d?q=1#f");
+            BOOST_TEST(u.params().size() == 1);
+        }
+
+        // replaces the previous contents
+        {
+            url u("ftp://u@old.example/long/path?x#y");
+            resolve(url_view("http://h/a"),
+                url_view("b"), u);
+            BOOST_TEST(u.encoded_url() == "http://h/b");
+            BOOST_TEST(! u.has_userinfo());
+            BOOST_TEST(u.scheme_id() == scheme::http);
+        }
+    }
+
+    void
+    testError()
+    {
+        url u("http://x");
+        error_code ec;
+        resolve(url_view("/a/b"),
+            url_view("c"), u, ec);
+        BOOST_TEST(ec == error::missing_scheme);
+        BOOST_TEST(u.encoded_url() == "http://x");
+
+        BOOST_TEST_THROWS(resolve(
+            url_view("//h/a"), url_view("c"), u),
+            invalid_part);
+
+        resolve(url_view("http://h/a"),
+            url_view("c"), u, ec);
+        BOOST_TEST(! ec);
+    }
+
+    void
+    run()
+    {
+        testExamples();
+        testResolve();
+        testStorage();
+        testError();
+    }
+};
+
+TEST_SUITE(
+    resolve_test,
+    "boost.url.resolve");
+
+} // urls
+} // boost
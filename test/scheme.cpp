@@ -31,6 +31,19 @@ public:
         BOOST_TEST(! is_special("gopher"));
         BOOST_TEST(! is_special("magnet"));
         BOOST_TEST(! is_special("mailto"));
+
+        BOOST_TEST(string_to_scheme("HTTPS") == scheme::https);
+        BOOST_TEST(string_to_scheme("FiLe") == scheme::file);
+        BOOST_TEST(string_to_scheme("htt") == scheme::unknown);
+        BOOST_TEST(string_to_scheme("") == scheme::unknown);
+
+        BOOST_TEST(default_port(scheme::ftp) == 21);
+        BOOST_TEST(default_port(scheme::file) == 0);
+        BOOST_TEST(default_port(scheme::http) == 80);
+        BOOST_TEST(default_port(scheme::https) == 443);
+        BOOST_TEST(default_port(scheme::ws) == 80);
+        BOOST_TEST(default_port(scheme::wss) == 443);
+        BOOST_TEST(default_port(scheme::unknown) == 0);
     }
 };
 
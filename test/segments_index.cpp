@@ -0,0 +1,214 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/segments_index.hpp>
+
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+class segments_index_test
+{
+public:
+    // compare the index against
+    // the bidirectional iterators
+    void
+    check(string_view s)
+    {
+        url_view const u(s);
+        std::vector<string_view> v0;
+        for(auto const& t : u.segments())
+            v0.push_back(t.encoded_string());
+
+        static_segments_index<8> idx;
+        auto const segs = u.segments(idx);
+        BOOST_TEST(idx.size() == v0.size());
+        if(! BOOST_TEST(segs.size() == v0.size()))
+            return;
+        BOOST_TEST(segs.empty() == v0.empty());
+        for(std::size_t i = 0; i < v0.size(); ++i)
+        {
+            BOOST_TEST(segs[i].encoded_string() == v0[i]);
+
+            // decoded only when escaped
+            char buf[32];
+            auto const d = segs[i].string(
+                buf, sizeof(buf));
+            BOOST_TEST(d == segs[i].string());
+            BOOST_TEST((d.data() == buf) == (
+                v0[i].find('%') != string_view::npos));
+        }
+        BOOST_TEST(static_cast<std::size_t>(
+            segs.end() - segs.begin()) == v0.size());
+
+        // walk backwards
+        auto it = segs.end();
+        auto i = v0.size();
+        while(it != segs.begin())
+        {
+            --it;
+            --i;
+            BOOST_TEST(it->encoded_string() == v0[i]);
+        }
+    }
+
+    void
+    testIndex()
+    {
+        check("");
+        check("/");
+        check("x:");
+        check("/a");
+        check("/a/");
+        check("a/b/c");
+        check("a//b");
+        check("/path/to/file.txt");
+        check("/path/to/file.txt?q=/x#/f");
+        check("http://h");
+        check("http://h/");
+        check("http://h//");
+        check("http://u:p@h:80/a/%2F/b?q#f");
+        check("x:a/b");
+        check("/%41");
+        check("/%41/b/%43%44/");
+        check("a/%2F%2F/c?%41#%41");
+        check("/a/b/c%20");
+    }
+
+    void
+    testStorage()
+    {
+        // caller-provided storage
+        std::size_t buf[4];
+        basic_segments_index idx(buf, 3);
+        BOOST_TEST(idx.capacity() == 3);
+        BOOST_TEST(idx.size() == 0);
+
+        url_view const u("/a/b/c");
+        auto const segs = u.segments(idx);
+        BOOST_TEST(idx.size() == 3);
+        BOOST_TEST(segs.front().encoded_string() == "a");
+        BOOST_TEST(segs.back().encoded_string() == "c");
+
+        url_view const v("/a/b/c/d");
+        BOOST_TEST_THROWS(v.segments(idx), too_large);
+
+        static_segments_index<0> idx0;
+        BOOST_TEST(url_view("").segments(idx0).empty());
+        BOOST_TEST_THROWS(
+            url_view("/a").segments(idx0), too_large);
+    }
+
+    void
+    testIterator()
+    {
+        using T = url_view::indexed_segments_type;
+        BOOST_TEST((std::is_same<
+            std::iterator_traits<T::iterator>::iterator_category,
+            std::random_access_iterator_tag>::value));
+        BOOST_TEST((std::is_same<
+            std::iterator_traits<T::iterator>::reference,
+            T::value_type>::value));
+
+        static_segments_index<8> idx;
+        url_view const u("/a/bb/ccc/dddd");
+        auto const segs = u.segments(idx);
+        auto it = segs.begin();
+        BOOST_TEST(it[3].encoded_string() == "dddd");
+        BOOST_TEST((it + 2)->encoded_string() == "ccc");
+        BOOST_TEST((2 + it)->encoded_string() == "ccc");
+        BOOST_TEST((segs.end() - 1)->encoded_string() == "dddd");
+        it += 3;
+        BOOST_TEST(it->encoded_string() == "dddd");
+        it -= 2;
+        BOOST_TEST((*it).encoded_string() == "bb");
+        BOOST_TEST(it++ == segs.begin() + 1);
+        BOOST_TEST(it-- == segs.begin() + 2);
+        BOOST_TEST(segs.begin() < it);
+        BOOST_TEST(segs.begin() <= it);
+        BOOST_TEST(segs.end() > it);
+        BOOST_TEST(segs.end() >= it);
+        BOOST_TEST(it != segs.end());
+        BOOST_TEST(T::iterator() == T::iterator());
+
+        // the standard algorithms take
+        // the random access paths
+        BOOST_TEST(std::distance(
+            segs.begin(), segs.end()) == 4);
+        BOOST_TEST(std::prev(segs.end())->
+            encoded_string() == "dddd");
+        BOOST_TEST(std::next(segs.begin(), 2)->
+            encoded_string() == "ccc");
+        {
+            auto it2 = segs.end();
+            std::advance(it2, -3);
+            BOOST_TEST(it2->encoded_string() == "bb");
+            std::advance(it2, 2);
+            BOOST_TEST(it2->encoded_string() == "dddd");
+        }
+
+        // binary search over sorted segments
+        auto const pos = std::lower_bound(
+            segs.begin(), segs.end(), "c",
+            []( T::value_type const& a,
+                char const* b)
+            {
+                return a.encoded_string() < b;
+            });
+        BOOST_TEST(pos - segs.begin() == 2);
+
+        T const empty;
+        BOOST_TEST(empty.empty());
+        BOOST_TEST(empty.begin() == empty.end());
+    }
+
+    void
+    testUrl()
+    {
+        url u("http://example.com/a/b");
+        static_segments_index<4> idx;
+        {
+            auto const segs = static_cast<
+                url const&>(u).segments(idx);
+            BOOST_TEST(segs.size() == 2);
+            BOOST_TEST(segs[1].encoded_string() == "b");
+        }
+        u.set_encoded_path("/x/y/z");
+        {
+            auto const segs = static_cast<
+                url const&>(u).segments(idx);
+            BOOST_TEST(segs.size() == 3);
+            BOOST_TEST(segs[0].encoded_string() == "x");
+            BOOST_TEST(segs[2].encoded_string() == "z");
+        }
+    }
+
+    void
+    run()
+    {
+        testIndex();
+        testStorage();
+        testIterator();
+        testUrl();
+    }
+};
+
+TEST_SUITE(segments_index_test, "boost.url.segments_index");
+
+} // urls
+} // boost
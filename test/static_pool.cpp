@@ -10,9 +10,13 @@
 // Test that header file is self-contained.
 #include <boost/url/static_pool.hpp>
 
+#include <boost/url/url.hpp>
 #include "test_suite.hpp"
 
+#include <cstdint>
 #include <iostream>
+#include <new>
+#include <string>
 
 namespace boost {
 namespace urls {
@@ -20,9 +24,304 @@ namespace urls {
 class static_pool_test
 {
 public:
+    using allocator_type =
+        basic_static_pool::allocator_type<char>;
+
+    using url_type = basic_url<allocator_type>;
+
+    // appends a segment to the path
+    static
+    void
+    grow(url_type& u)
+    {
+        auto const s = u.encoded_path();
+        u.set_encoded_path(std::string(
+            s.data(), s.size()) + "/abc");
+    }
+
+    void
+    testDeallocate()
+    {
+        static_pool<64> sp;
+        auto a = sp.allocator();
+        BOOST_TEST(sp.capacity() == 64);
+        BOOST_TEST(sp.size() == 0);
+        auto p0 = a.allocate(10);
+        auto p1 = a.allocate(20);
+        BOOST_TEST(sp.size() == 30);
+
+        // not the most recent block
+        a.deallocate(p0, 10);
+        BOOST_TEST(sp.size() == 30);
+
+        // the most recent block
+        a.deallocate(p1, 20);
+        BOOST_TEST(sp.size() == 10);
+        auto p2 = a.allocate(20);
+        BOOST_TEST(p2 == p1);
+
+        BOOST_TEST_THROWS(a.allocate(35),
+            std::bad_alloc);
+        BOOST_TEST(sp.size() == 30);
+    }
+
+    void
+    testExtend()
+    {
+        static_pool<64> sp;
+        auto a = sp.allocator();
+        auto p0 = a.allocate(10);
+        BOOST_TEST(a.try_extend(p0, 10, 20));
+        BOOST_TEST(sp.size() == 20);
+        BOOST_TEST(! a.try_extend(p0, 20, 65));
+        BOOST_TEST(sp.size() == 20);
+        BOOST_TEST(a.try_extend(p0, 20, 64));
+        BOOST_TEST(sp.size() == 64);
+        a.deallocate(p0, 64);
+        BOOST_TEST(sp.size() == 0);
+
+        // not the most recent block
+        p0 = a.allocate(10);
+        a.allocate(10);
+        BOOST_TEST(! a.try_extend(p0, 10, 20));
+        BOOST_TEST(sp.size() == 20);
+    }
+
+    void
+    testScope()
+    {
+        static_pool<256> sp;
+        auto a = sp.allocator();
+        a.allocate(8);
+        auto const m = sp.mark();
+        a.allocate(100);
+        BOOST_TEST(sp.size() == 108);
+        sp.rewind(m);
+        BOOST_TEST(sp.size() == 8);
+
+        for(int i = 0; i < 10; ++i)
+        {
+            basic_static_pool::scope s(sp);
+            url_type u(
+                "http://www.example.com/path/to/file.txt",
+                sp.allocator());
+            u.set_encoded_query("q=1");
+            BOOST_TEST(sp.size() > 8);
+        }
+        BOOST_TEST(sp.size() == 8);
+
+        // a block from before the scope
+        // is not grown past its marker
+        {
+            auto const p = a.allocate(8);
+            BOOST_TEST(sp.size() == 16);
+            {
+                basic_static_pool::scope s(sp);
+                BOOST_TEST(! a.try_extend(p, 8, 100));
+                auto const q = a.allocate(4);
+                BOOST_TEST(a.try_extend(q, 4, 50));
+                BOOST_TEST(sp.size() == 66);
+            }
+            BOOST_TEST(sp.size() == 16);
+            BOOST_TEST(a.try_extend(p, 8, 100));
+            BOOST_TEST(sp.size() == 108);
+            a.deallocate(p, 100);
+            BOOST_TEST(sp.size() == 8);
+        }
+
+        // nor given back below it
+        {
+            auto const p = a.allocate(8);
+            {
+                basic_static_pool::scope s(sp);
+                a.deallocate(p, 8);
+                BOOST_TEST(sp.size() == 16);
+                a.allocate(4);
+                BOOST_TEST(sp.size() == 20);
+            }
+            BOOST_TEST(sp.size() == 16);
+            a.deallocate(p, 8);
+            BOOST_TEST(sp.size() == 8);
+        }
+    }
+
+    void
+    testGrowth()
+    {
+        // a growing url does not
+        // leave old blocks behind
+        static_pool<256> sp;
+        url_type u(sp.allocator());
+        u.set_encoded_url("http://www.example.com");
+        for(int i = 0; i < 20; ++i)
+            grow(u);
+        BOOST_TEST(u.encoded_url().size() == 102);
+        BOOST_TEST(sp.size() == u.capacity() + 1);
+        BOOST_TEST(u.capacity() == u.encoded_url().size());
+
+        // two urls growing in turn
+        static_pool<1024> sp2;
+        url_type u0(sp2.allocator());
+        url_type u1(sp2.allocator());
+        for(int i = 0; i < 10; ++i)
+        {
+            grow(u0);
+            grow(u1);
+        }
+        BOOST_TEST(u0.encoded_url() == u1.encoded_url());
+        BOOST_TEST(sp2.size() <= 1024);
+
+        // exhausted
+        static_pool<32> sp3;
+        url_type u3(sp3.allocator());
+        BOOST_TEST_THROWS(u3.set_encoded_url(
+            "http://www.example.com/path/to/file.txt"),
+            std::bad_alloc);
+    }
+
+    // counts the memory outstanding
+    struct counting_upstream
+        : basic_static_pool::upstream
+    {
+        std::size_t count = 0;
+        std::size_t bytes = 0;
+
+        void*
+        allocate(
+            std::size_t n,
+            std::size_t align) override
+        {
+            auto const p = basic_static_pool::
+                new_delete_upstream().allocate(
+                    n, align);
+            ++count;
+            bytes += n;
+            return p;
+        }
+
+        void
+        deallocate(
+            void* p,
+            std::size_t n,
+            std::size_t align) noexcept override
+        {
+            --count;
+            bytes -= n;
+            basic_static_pool::
+                new_delete_upstream().deallocate(
+                    p, n, align);
+        }
+    };
+
+    void
+    testUpstream()
+    {
+        counting_upstream up;
+        {
+            static_pool<32> sp(up);
+            auto a = sp.allocator();
+            auto p0 = a.allocate(20);
+            auto p1 = a.allocate(20);
+            BOOST_TEST(up.count == 1);
+            BOOST_TEST(up.bytes == 20);
+            BOOST_TEST(sp.size() == 20);
+            a.deallocate(p1, 20);
+            BOOST_TEST(up.count == 0);
+            a.deallocate(p0, 20);
+            BOOST_TEST(sp.size() == 0);
+
+            // a url which does not fit
+            url_type u(
+                "http://www.example.com/path/to/file.txt",
+                sp.allocator());
+            BOOST_TEST(u.encoded_url() ==
+                "http://www.example.com/path/to/file.txt");
+            BOOST_TEST(up.count == 1);
+        }
+        BOOST_TEST(up.count == 0);
+        BOOST_TEST(up.bytes == 0);
+
+        // aligning the top goes past the end
+        {
+            alignas(8) char buf[20];
+            basic_static_pool sp(buf, sizeof(buf), up);
+            auto a = sp.allocator();
+            a.allocate(19);
+            basic_static_pool::allocator_type<
+                std::uint64_t> a8(a);
+            auto const p = a8.allocate(1);
+            BOOST_TEST(up.count == 1);
+            BOOST_TEST(sp.size() == 19);
+            BOOST_TEST(sp.stats().overflows == 1);
+            a8.deallocate(p, 1);
+            BOOST_TEST(up.count == 0);
+        }
+
+        // the default upstream
+        {
+            static_pool<16> sp(basic_static_pool::
+                new_delete_upstream());
+            url_type u(sp.allocator());
+            for(int i = 0; i < 10; ++i)
+                grow(u);
+            BOOST_TEST(u.encoded_path().size() == 40);
+            BOOST_TEST(sp.stats().overflows > 0);
+        }
+    }
+
+    void
+    testStats()
+    {
+        counting_upstream up;
+        static_pool<64> sp(up);
+        auto a = sp.allocator();
+        auto st = sp.stats();
+        BOOST_TEST(st.allocations == 0);
+        BOOST_TEST(st.overflows == 0);
+        BOOST_TEST(st.used == 0);
+        BOOST_TEST(st.high_water == 0);
+
+        auto const m = sp.mark();
+        a.allocate(10);
+        auto p = a.allocate(20);
+        BOOST_TEST(a.try_extend(p, 20, 30));
+        st = sp.stats();
+        BOOST_TEST(st.allocations == 2);
+        BOOST_TEST(st.used == 40);
+        BOOST_TEST(st.high_water == 40);
+
+        auto q = a.allocate(30);
+        st = sp.stats();
+        BOOST_TEST(st.allocations == 2);
+        BOOST_TEST(st.overflows == 1);
+        BOOST_TEST(st.used == 40);
+        a.deallocate(q, 30);
+
+        sp.rewind(m);
+        a.allocate(5);
+        st = sp.stats();
+        BOOST_TEST(st.allocations == 3);
+        BOOST_TEST(st.used == 5);
+        BOOST_TEST(st.high_water == 40);
+
+        sp.reset_stats();
+        st = sp.stats();
+        BOOST_TEST(st.allocations == 0);
+        BOOST_TEST(st.overflows == 0);
+        BOOST_TEST(st.used == 5);
+        BOOST_TEST(st.high_water == 5);
+        BOOST_TEST(up.count == 0);
+    }
+
     void
     run()
     {
+        testDeallocate();
+        testExtend();
+        testScope();
+        testGrowth();
+        testUpstream();
+        testStats();
     }
 };
 
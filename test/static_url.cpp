@@ -18,11 +18,130 @@ namespace urls {
 class static_url_test
 {
 public:
-    //------------------------------------------------------
+    template<std::size_t N>
+    static
+    bool
+    is_inside(static_url<N> const& u)
+    {
+        auto const p = u.encoded_url().data();
+        return
+            p >= reinterpret_cast<char const*>(&u) &&
+            p < reinterpret_cast<char const*>(&u + 1);
+    }
+
+    void
+    testCtor()
+    {
+        {
+            static_url<16> u;
+            BOOST_TEST(u.encoded_url() == "");
+            BOOST_TEST(u.capacity() == 16);
+            BOOST_TEST(*u.data() == 0);
+        }
+        {
+            static_url<32> u("http://x.com/a?b#c");
+            BOOST_TEST(u.encoded_url() == "http://x.com/a?b#c");
+            BOOST_TEST(u.encoded_host() == "x.com");
+            BOOST_TEST(u.capacity() == 32);
+            BOOST_TEST(is_inside(u));
+        }
+        {
+            // exactly full
+            static_url<8> u("http://x");
+            BOOST_TEST(u.encoded_url() == "http://x");
+            BOOST_TEST(u.data()[8] == 0);
+        }
+        BOOST_TEST_THROWS(static_url<8>(
+            "http://xy"), too_large);
+        {
+            // from a view
+            url_view const v("http://x.com/a?b#c");
+            static_url<32> u(v);
+            BOOST_TEST(u.encoded_url() == v.encoded_url());
+            BOOST_TEST(u.encoded_query() == "b");
+            BOOST_TEST(is_inside(u));
+            u.assign(url_view("//h/p"));
+            BOOST_TEST(u.encoded_url() == "//h/p");
+            BOOST_TEST(u.segments().size() == 1);
+            BOOST_TEST_THROWS(static_url<8>{v}, too_large);
+            BOOST_TEST_THROWS(u.assign(url_view(
+                "http://www.example.com/index.html")), too_large);
+            BOOST_TEST(u.encoded_url() == "//h/p");
+        }
+        BOOST_TEST_THROWS(static_url<32>(
+            "http://[x"), invalid_part);
+    }
+
+    void
+    testCapacity()
+    {
+        static_url<16> u("http://x.com/");
+        BOOST_TEST_THROWS(u.set_encoded_path(
+            "/a/long/path"), too_large);
+        // unchanged
+        BOOST_TEST(u.encoded_url() == "http://x.com/");
+        BOOST_TEST(u.encoded_path() == "/");
+        u.set_encoded_path("/abc");
+        BOOST_TEST(u.encoded_url() == "http://x.com/abc");
+        BOOST_TEST_THROWS(u.set_encoded_url(
+            "http://example.com/"), too_large);
+        BOOST_TEST(u.encoded_url() == "http://x.com/abc");
+        BOOST_TEST_THROWS(u.segments().insert(
+            u.segments().end(), "file.txt"), too_large);
+        BOOST_TEST(u.segments().size() == 1);
+        u.set_encoded_url("//h");
+        BOOST_TEST(u.encoded_url() == "//h");
+        BOOST_TEST(is_inside(u));
+    }
+
+    void
+    testCopy()
+    {
+        static_url<64> const u0(
+            "http://u:p@h:81/a/b?k=v&j#f");
+        {
+            static_url<64> u(u0);
+            BOOST_TEST(u.encoded_url() == u0.encoded_url());
+            BOOST_TEST(is_inside(u));
+            BOOST_TEST(u.port_number() == 81);
+            BOOST_TEST(u.segments().size() == 2);
+            BOOST_TEST(u.params().size() == 2);
+            u.set_encoded_path("/c");
+            BOOST_TEST(u.encoded_url() == "http://u:p@h:81/c?k=v&j#f");
+            BOOST_TEST(u0.encoded_url() == "http://u:p@h:81/a/b?k=v&j#f");
+        }
+        {
+            static_url<64> u("x:y");
+            u = u0;
+            BOOST_TEST(u.encoded_url() == u0.encoded_url());
+            BOOST_TEST(u.encoded_password() == "p");
+            BOOST_TEST(is_inside(u));
+            u = u;
+            BOOST_TEST(u.encoded_url() == u0.encoded_url());
+            u = static_url<64>();
+            BOOST_TEST(u.encoded_url() == "");
+            BOOST_TEST(u.host_type() == host_type::none);
+        }
+        {
+            // other capacities
+            static_url<128> u(u0);
+            BOOST_TEST(u.encoded_url() == u0.encoded_url());
+            static_url<32> u1;
+            u1 = u;
+            BOOST_TEST(u1.encoded_url() == u0.encoded_url());
+            static_url<8> u2("x:y");
+            BOOST_TEST_THROWS(u2 = u, too_large);
+            BOOST_TEST(u2.encoded_url() == "x:y");
+            BOOST_TEST_THROWS(static_url<8>{u}, too_large);
+        }
+    }
 
     void
     run()
     {
+        testCtor();
+        testCapacity();
+        testCopy();
     }
 };
 